@@ -0,0 +1,164 @@
+#include "acpi.h"
+#include "apic.h"
+#include "memory.h"
+#include <string.h>
+
+static acpi_madt_info_t madt_info;
+
+// 바이트 합이 0이어야 유효한 테이블
+static uint8_t acpi_checksum(const void* data, uint32_t length) {
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint8_t sum = 0;
+    
+    for (uint32_t i = 0; i < length; i++) {
+        sum += bytes[i];
+    }
+    return sum;
+}
+
+// 16바이트 경계마다 RSDP 서명 검사
+static acpi_rsdp_t* rsdp_scan(uint32_t start, uint32_t end) {
+    for (uint32_t addr = start; addr + sizeof(acpi_rsdp_t) <= end; addr += 16) {
+        acpi_rsdp_t* rsdp = (acpi_rsdp_t*)addr;
+        if (memcmp(rsdp->signature, "RSD PTR ", 8) == 0 && acpi_checksum(rsdp, sizeof(acpi_rsdp_t)) == 0) {
+            return rsdp;
+        }
+    }
+    return NULL;
+}
+
+static acpi_rsdp_t* rsdp_find(void) {
+    // EBDA 세그먼트는 BIOS 데이터 영역에 있음 (0번 페이지는 NULL 검사용으로 매핑하지 않으므로 따로 매핑)
+    uint8_t* bda = (uint8_t*)ioremap(0, PAGE_SIZE);
+    if (bda) {
+        uint32_t ebda = (uint32_t)*(uint16_t*)(bda + ACPI_EBDA_POINTER) << 4;
+        iounmap(bda, PAGE_SIZE);
+        if (ebda >= PAGE_SIZE && ebda < ACPI_RSDP_SEARCH_START) {
+            acpi_rsdp_t* rsdp = rsdp_scan(ebda, ebda + ACPI_EBDA_SEARCH_SIZE);
+            if (rsdp) return rsdp;
+        }
+    }
+    
+    return rsdp_scan(ACPI_RSDP_SEARCH_START, ACPI_RSDP_SEARCH_END);
+}
+
+// 테이블 헤더만 잠깐 매핑해 서명과 길이 확인 (signature가 NULL이면 서명은 보지 않음, 맞지 않으면 0)
+static uint32_t acpi_table_length(uint32_t physical_addr, const char* signature) {
+    acpi_sdt_header_t* header = (acpi_sdt_header_t*)ioremap(physical_addr, sizeof(acpi_sdt_header_t));
+    if (!header) return 0;
+    
+    uint32_t length = header->length;
+    if (signature && memcmp(header->signature, signature, 4) != 0) {
+        length = 0;
+    }
+    iounmap(header, sizeof(acpi_sdt_header_t));
+    return length >= sizeof(acpi_sdt_header_t) ? length : 0;
+}
+
+// 테이블 전체 매핑 (헤더로 길이를 확인한 뒤 다시 매핑, 체크섬이 틀리면 NULL)
+static acpi_sdt_header_t* acpi_map_table(uint32_t physical_addr, const char* signature) {
+    uint32_t length = acpi_table_length(physical_addr, signature);
+    if (!length) return NULL;
+    
+    acpi_sdt_header_t* header = (acpi_sdt_header_t*)ioremap(physical_addr, length);
+    if (header && acpi_checksum(header, length) != 0) {
+        iounmap(header, length);
+        return NULL;
+    }
+    return header;
+}
+
+// RSDT에서 서명이 일치하는 테이블 찾기 (서명이 다른 테이블은 헤더만 보고 바로 해제)
+static acpi_sdt_header_t* acpi_find_table(acpi_sdt_header_t* rsdt, const char* signature) {
+    uint32_t count = (rsdt->length - sizeof(acpi_sdt_header_t)) / sizeof(uint32_t);
+    uint32_t* entries = (uint32_t*)(rsdt + 1);
+    
+    for (uint32_t i = 0; i < count; i++) {
+        acpi_sdt_header_t* table = acpi_map_table(entries[i], signature);
+        if (table) return table;
+    }
+    return NULL;
+}
+
+// MADT 엔트리에서 CPU, I/O APIC, ISA IRQ 재지정 정보 수집
+static void madt_parse(acpi_madt_t* madt) {
+    madt_info.lapic_address = madt->lapic_address;
+    madt_info.flags = madt->flags;
+    
+    uint8_t* entry = (uint8_t*)(madt + 1);
+    uint8_t* end = (uint8_t*)madt + madt->header.length;
+    
+    while (entry + sizeof(madt_entry_t) <= end) {
+        madt_entry_t* header = (madt_entry_t*)entry;
+        if (header->length < sizeof(madt_entry_t) || entry + header->length > end) break;
+        
+        switch (header->type) {
+            case MADT_TYPE_LAPIC: {
+                madt_lapic_t* lapic = (madt_lapic_t*)entry;
+                if ((lapic->flags & (MADT_LAPIC_ENABLED | MADT_LAPIC_ONLINE_CAPABLE)) &&
+                    madt_info.cpu_count < ACPI_MAX_CPUS) {
+                    madt_info.cpu_apic_ids[madt_info.cpu_count++] = lapic->apic_id;
+                }
+                break;
+            }
+            case MADT_TYPE_IOAPIC: {
+                madt_ioapic_t* ioapic = (madt_ioapic_t*)entry;
+                if (madt_info.ioapic_count < ACPI_MAX_IOAPICS) {
+                    acpi_ioapic_t* info = &madt_info.ioapics[madt_info.ioapic_count++];
+                    info->id = ioapic->ioapic_id;
+                    info->address = ioapic->address;
+                    info->gsi_base = ioapic->gsi_base;
+                }
+                break;
+            }
+            case MADT_TYPE_OVERRIDE: {
+                madt_override_t* override = (madt_override_t*)entry;
+                if (override->bus == 0 && override->source < ACPI_ISA_IRQS) {
+                    madt_info.isa_gsi[override->source] = override->gsi;
+                    madt_info.isa_flags[override->source] = override->flags;
+                }
+                break;
+            }
+            case MADT_TYPE_LAPIC_ADDRESS: {
+                madt_lapic_address_t* address = (madt_lapic_address_t*)entry;
+                if (address->address < 0x100000000ULL) {
+                    madt_info.lapic_address = (uint32_t)address->address;
+                }
+                break;
+            }
+        }
+        
+        entry += header->length;
+    }
+}
+
+// ACPI 초기화 (MADT가 없으면 -1, 단일 CPU와 8259 PIC로 동작)
+int acpi_init(void) {
+    memset(&madt_info, 0, sizeof(madt_info));
+    madt_info.lapic_address = LAPIC_DEFAULT_BASE;
+    for (uint32_t irq = 0; irq < ACPI_ISA_IRQS; irq++) {
+        madt_info.isa_gsi[irq] = irq; // 재지정이 없으면 ISA IRQ = GSI
+    }
+    
+    acpi_rsdp_t* rsdp = rsdp_find();
+    if (!rsdp) return -1;
+    
+    acpi_sdt_header_t* rsdt = acpi_map_table(rsdp->rsdt_address, "RSDT");
+    if (!rsdt) return -1;
+    
+    acpi_madt_t* madt = (acpi_madt_t*)acpi_find_table(rsdt, "APIC");
+    if (!madt) {
+        iounmap(rsdt, rsdt->length);
+        return -1;
+    }
+    
+    // 필요한 정보는 모두 복사하므로 매핑은 돌려줌 (나중에 매핑한 것부터)
+    madt_parse(madt);
+    iounmap(madt, madt->header.length);
+    iounmap(rsdt, rsdt->length);
+    return madt_info.cpu_count ? 0 : -1;
+}
+
+const acpi_madt_info_t* acpi_get_madt(void) {
+    return &madt_info;
+}
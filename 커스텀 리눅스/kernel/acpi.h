@@ -0,0 +1,113 @@
+#ifndef ACPI_H
+#define ACPI_H
+
+#include <stdint.h>
+
+// RSDP 검색 범위 (BIOS 읽기 전용 영역과 EBDA 첫 1KB)
+#define ACPI_RSDP_SEARCH_START 0xE0000
+#define ACPI_RSDP_SEARCH_END 0x100000
+#define ACPI_EBDA_POINTER 0x40E
+#define ACPI_EBDA_SEARCH_SIZE 1024
+
+// MADT에서 모으는 최대 개수
+#define ACPI_MAX_CPUS 16
+#define ACPI_MAX_IOAPICS 4
+#define ACPI_ISA_IRQS 16
+
+// RSDP (ACPI 1.0 부분만 사용, 32비트 커널은 RSDT로 충분)
+typedef struct {
+    char signature[8];              // "RSD PTR "
+    uint8_t checksum;
+    char oem_id[6];
+    uint8_t revision;
+    uint32_t rsdt_address;
+} __attribute__((packed)) acpi_rsdp_t;
+
+// 시스템 기술 테이블 공통 헤더
+typedef struct {
+    char signature[4];
+    uint32_t length;                // 헤더 포함 테이블 전체 길이
+    uint8_t revision;
+    uint8_t checksum;
+    char oem_id[6];
+    char oem_table_id[8];
+    uint32_t oem_revision;
+    uint32_t creator_id;
+    uint32_t creator_revision;
+} __attribute__((packed)) acpi_sdt_header_t;
+
+// MADT ("APIC") 헤더 (뒤에 가변 길이 엔트리가 이어짐)
+typedef struct {
+    acpi_sdt_header_t header;
+    uint32_t lapic_address;
+    uint32_t flags;
+} __attribute__((packed)) acpi_madt_t;
+
+#define MADT_FLAG_PCAT_COMPAT 0x1   // 8259 PIC도 존재
+
+// MADT 엔트리 종류
+#define MADT_TYPE_LAPIC 0
+#define MADT_TYPE_IOAPIC 1
+#define MADT_TYPE_OVERRIDE 2
+#define MADT_TYPE_LAPIC_ADDRESS 5
+
+#define MADT_LAPIC_ENABLED 0x1
+#define MADT_LAPIC_ONLINE_CAPABLE 0x2
+
+typedef struct {
+    uint8_t type;
+    uint8_t length;
+} __attribute__((packed)) madt_entry_t;
+
+typedef struct {
+    madt_entry_t entry;
+    uint8_t processor_id;
+    uint8_t apic_id;
+    uint32_t flags;
+} __attribute__((packed)) madt_lapic_t;
+
+typedef struct {
+    madt_entry_t entry;
+    uint8_t ioapic_id;
+    uint8_t reserved;
+    uint32_t address;
+    uint32_t gsi_base;
+} __attribute__((packed)) madt_ioapic_t;
+
+typedef struct {
+    madt_entry_t entry;
+    uint8_t bus;
+    uint8_t source;                 // ISA IRQ
+    uint32_t gsi;
+    uint16_t flags;                 // 극성/트리거 (MPS INTI 플래그)
+} __attribute__((packed)) madt_override_t;
+
+typedef struct {
+    madt_entry_t entry;
+    uint16_t reserved;
+    uint64_t address;
+} __attribute__((packed)) madt_lapic_address_t;
+
+// 파싱한 MADT 정보
+typedef struct {
+    uint32_t id;
+    uint32_t address;
+    uint32_t gsi_base;
+} acpi_ioapic_t;
+
+typedef struct {
+    uint32_t lapic_address;
+    uint32_t flags;
+    uint32_t cpu_count;
+    uint8_t cpu_apic_ids[ACPI_MAX_CPUS];    // 사용 가능한 CPU의 Local APIC ID
+    uint32_t ioapic_count;
+    acpi_ioapic_t ioapics[ACPI_MAX_IOAPICS];
+    uint32_t isa_gsi[ACPI_ISA_IRQS];        // ISA IRQ가 연결된 GSI
+    uint16_t isa_flags[ACPI_ISA_IRQS];
+} acpi_madt_info_t;
+
+// ACPI 함수들
+int acpi_init(void);
+const acpi_madt_info_t* acpi_get_madt(void);
+
+#endif // ACPI_H
@@ -0,0 +1,65 @@
+; AP 부팅 트램펄린
+; 실제 모드로 시작하는 AP를 보호 모드와 페이징으로 전환한 뒤 smp_ap_main 호출
+; BSP가 AP_TRAMPOLINE_ADDR로 복사하고 SIPI 벡터로 이 주소를 지정 (smp.h와 주소 일치)
+
+%define AP_TRAMPOLINE_ADDR 0x1000
+%define TRAMPOLINE(label) (AP_TRAMPOLINE_ADDR + (label) - ap_trampoline_start)
+
+section .data
+
+global ap_trampoline_start
+global ap_trampoline_end
+global ap_boot_data
+
+[bits 16]
+ap_trampoline_start:
+    cli
+    cld
+    xor ax, ax
+    mov ds, ax
+
+    ; 커널 GDT를 그대로 사용 (BSP가 ap_boot_gdtr에 채워 둠)
+    o32 lgdt [TRAMPOLINE(ap_boot_gdtr)]
+
+    mov eax, cr0
+    or eax, 1                   ; PE 비트
+    mov cr0, eax
+    jmp dword 0x08:TRAMPOLINE(ap_protected_mode)
+
+[bits 32]
+ap_protected_mode:
+    mov ax, 0x10
+    mov ds, ax
+    mov es, ax
+    mov fs, ax
+    mov gs, ax
+    mov ss, ax
+
+    ; BSP와 같은 CR4(PSE/PGE)와 커널 페이지 디렉토리로 페이징 활성화
+    mov eax, [TRAMPOLINE(ap_boot_cr4)]
+    mov cr4, eax
+    mov eax, [TRAMPOLINE(ap_boot_cr3)]
+    mov cr3, eax
+    mov eax, cr0
+    or eax, 0x80000000          ; PG 비트
+    mov cr0, eax
+
+    ; 이 AP의 유휴 스택으로 전환 후 C 코드로 (반환하지 않음)
+    mov esp, [TRAMPOLINE(ap_boot_stack)]
+    mov eax, [TRAMPOLINE(ap_boot_entry)]
+    call eax
+.hang:
+    cli
+    hlt
+    jmp .hang
+
+; BSP가 채우는 부팅 정보 (smp.c의 ap_boot_data_t와 배치 일치)
+align 4
+ap_boot_data:
+ap_boot_cr3:    dd 0
+ap_boot_cr4:    dd 0
+ap_boot_stack:  dd 0
+ap_boot_entry:  dd 0
+ap_boot_gdtr:   dw 0
+                dd 0
+ap_trampoline_end:
@@ -0,0 +1,136 @@
+#include "apic.h"
+#include "ioapic.h"
+#include "acpi.h"
+#include "memory.h"
+#include "interrupt.h"
+#include "pit.h"
+
+// 타이머 보정 구간 (PIT 채널 2로 10ms를 여러 번 재서 가장 짧은 값, TSC 보정과 같은 방식)
+#define LAPIC_CALIBRATE_MS 10
+#define LAPIC_CALIBRATE_TRIES 5
+
+// 매핑된 Local APIC 레지스터 (모든 CPU가 같은 주소로 자기 APIC에 접근)
+static volatile uint32_t* lapic = NULL;
+
+uint32_t lapic_timer_khz = 0;
+
+static uint32_t lapic_read(uint32_t reg) {
+    return lapic[reg >> 2];
+}
+
+static void lapic_write(uint32_t reg, uint32_t value) {
+    lapic[reg >> 2] = value;
+}
+
+// APIC 초기화 (인터럽트를 끈 부팅 초기에 BSP에서 한 번)
+// Local APIC가 있으면 타이머를 보정하고, I/O APIC까지 있으면 장치 IRQ도 8259 PIC 대신 I/O APIC로
+int apic_init(void) {
+    if (acpi_init() < 0) return -1;
+    
+    const acpi_madt_info_t* madt = acpi_get_madt();
+    if (lapic_init(madt->lapic_address) < 0) return -1;
+    
+    lapic_timer_calibrate();
+    
+    if (ioapic_init(madt) == 0) {
+        irq_set_chip(&ioapic_chip);
+    }
+    return 0;
+}
+
+// Local APIC 초기화 (BSP에서 한 번, 레지스터 매핑 후 BSP의 APIC 활성화)
+int lapic_init(uint32_t physical_addr) {
+    uint32_t eax, ebx, ecx, edx;
+    __asm__ volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (1));
+    if (!(edx & CPUID_FEATURE_APIC)) return -1;
+    
+    lapic = (volatile uint32_t*)ioremap(physical_addr, PAGE_SIZE);
+    if (!lapic) return -1;
+    
+    lapic_enable();
+    return 0;
+}
+
+// 이 CPU의 Local APIC 활성화 (AP는 부팅 직후 호출)
+void lapic_enable(void) {
+    lapic_write(LAPIC_SVR, LAPIC_SVR_ENABLE | LAPIC_SPURIOUS_VECTOR);
+    lapic_write(LAPIC_TPR, 0); // 모든 우선순위의 인터럽트 허용
+}
+
+int lapic_available(void) {
+    return lapic != NULL;
+}
+
+uint32_t lapic_id(void) {
+    return lapic ? lapic_read(LAPIC_ID) >> 24 : 0;
+}
+
+void lapic_eoi(void) {
+    if (lapic) {
+        lapic_write(LAPIC_EOI, 0);
+    }
+}
+
+// 프로세서 간 인터럽트 전송 (전달될 때까지 대기)
+void lapic_send_ipi(uint32_t apic_id, uint32_t command) {
+    if (!lapic) return;
+    
+    // ICR 두 레지스터 사이에 인터럽트 핸들러가 IPI를 보내지 않도록
+    uint32_t flags = irq_save();
+    lapic_write(LAPIC_ICR_HIGH, apic_id << 24);
+    lapic_write(LAPIC_ICR_LOW, command);
+    while (lapic_read(LAPIC_ICR_LOW) & LAPIC_ICR_PENDING) {
+        __asm__ volatile("pause");
+    }
+    irq_restore(flags);
+}
+
+// 타이머 보정 (분주 16에서 1ms당 카운트, 버스 클럭은 CPU마다 같으므로 BSP에서 한 번)
+void lapic_timer_calibrate(void) {
+    if (!lapic) return;
+    
+    uint32_t best = 0xFFFFFFFF;
+    lapic_write(LAPIC_TIMER_DIVIDE, LAPIC_TIMER_DIVIDE_16);
+    lapic_write(LAPIC_LVT_TIMER, LAPIC_LVT_MASKED | LAPIC_TIMER_VECTOR);
+    
+    for (int i = 0; i < LAPIC_CALIBRATE_TRIES; i++) {
+        pit_channel2_start(PIT_FREQUENCY / (1000 / LAPIC_CALIBRATE_MS));
+        lapic_write(LAPIC_TIMER_INITIAL, 0xFFFFFFFF);
+        while (!pit_channel2_expired()) {
+            __asm__ volatile("pause");
+        }
+        uint32_t elapsed = 0xFFFFFFFF - lapic_read(LAPIC_TIMER_CURRENT);
+        
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    
+    lapic_write(LAPIC_TIMER_INITIAL, 0);
+    lapic_timer_khz = best / LAPIC_CALIBRATE_MS;
+}
+
+// 주기 모드 (count마다 LAPIC_TIMER_VECTOR 인터럽트)
+void lapic_timer_periodic(uint32_t count) {
+    lapic_write(LAPIC_TIMER_DIVIDE, LAPIC_TIMER_DIVIDE_16);
+    lapic_write(LAPIC_LVT_TIMER, LAPIC_TIMER_PERIODIC | LAPIC_TIMER_VECTOR);
+    lapic_write(LAPIC_TIMER_INITIAL, count);
+}
+
+// 단발 모드 (count 뒤에 한 번만 인터럽트)
+void lapic_timer_oneshot(uint32_t count) {
+    lapic_write(LAPIC_TIMER_DIVIDE, LAPIC_TIMER_DIVIDE_16);
+    lapic_write(LAPIC_LVT_TIMER, LAPIC_TIMER_VECTOR);
+    lapic_write(LAPIC_TIMER_INITIAL, count);
+}
+
+// 남은 카운트 (단발 모드가 끝났으면 0)
+uint32_t lapic_timer_read_count(void) {
+    return lapic_read(LAPIC_TIMER_CURRENT);
+}
+
+// 타이머 정지 (유휴 CPU는 IPI로만 깨어남)
+void lapic_timer_stop(void) {
+    lapic_write(LAPIC_LVT_TIMER, LAPIC_LVT_MASKED | LAPIC_TIMER_VECTOR);
+    lapic_write(LAPIC_TIMER_INITIAL, 0);
+}
@@ -0,0 +1,64 @@
+#ifndef APIC_H
+#define APIC_H
+
+#include <stdint.h>
+
+// Local APIC 기본 물리 주소 (MADT에 다른 주소가 있으면 그것을 사용)
+#define LAPIC_DEFAULT_BASE 0xFEE00000
+
+// Local APIC 레지스터 오프셋
+#define LAPIC_ID 0x20
+#define LAPIC_VERSION 0x30
+#define LAPIC_TPR 0x80
+#define LAPIC_EOI 0xB0
+#define LAPIC_SVR 0xF0
+#define LAPIC_ICR_LOW 0x300
+#define LAPIC_ICR_HIGH 0x310
+#define LAPIC_LVT_TIMER 0x320
+#define LAPIC_TIMER_INITIAL 0x380
+#define LAPIC_TIMER_CURRENT 0x390
+#define LAPIC_TIMER_DIVIDE 0x3E0
+
+// 스퓨리어스 벡터 레지스터
+#define LAPIC_SVR_ENABLE 0x100
+#define LAPIC_SPURIOUS_VECTOR 0xFF
+
+// 로컬 벡터 테이블 (LVT) 비트
+#define LAPIC_LVT_MASKED 0x10000
+#define LAPIC_TIMER_PERIODIC 0x20000
+
+// Local APIC 타이머 (버스 클럭을 16분주, CPU마다 자기 타이머로 선점 틱)
+#define LAPIC_TIMER_DIVIDE_16 0x3
+#define LAPIC_TIMER_VECTOR 0xEF
+
+// 프로세서 간 인터럽트 명령 (ICR 하위 32비트)
+#define LAPIC_ICR_FIXED 0x000
+#define LAPIC_ICR_INIT 0x500
+#define LAPIC_ICR_STARTUP 0x600
+#define LAPIC_ICR_PENDING 0x1000
+#define LAPIC_ICR_LEVEL_ASSERT 0x4000
+
+// CPUID 1번 기능 비트 (EDX)
+#define CPUID_FEATURE_APIC (1 << 9)
+
+extern uint32_t lapic_timer_khz;    // 1ms당 타이머 카운트 (보정 전이거나 APIC가 없으면 0)
+
+// APIC 초기화 (ACPI MADT로 Local APIC와 I/O APIC를 찾고, 없으면 8259 PIC로 계속)
+int apic_init(void);
+
+// Local APIC 함수들
+int lapic_init(uint32_t physical_addr);
+void lapic_enable(void);
+int lapic_available(void);
+uint32_t lapic_id(void);
+void lapic_eoi(void);
+void lapic_send_ipi(uint32_t apic_id, uint32_t command);
+
+// Local APIC 타이머 함수들 (호출한 CPU의 타이머, count는 분주 후 카운트)
+void lapic_timer_calibrate(void);
+void lapic_timer_periodic(uint32_t count);
+void lapic_timer_oneshot(uint32_t count);
+uint32_t lapic_timer_read_count(void);
+void lapic_timer_stop(void);
+
+#endif // APIC_H
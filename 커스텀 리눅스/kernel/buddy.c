@@ -0,0 +1,241 @@
+#include "buddy.h"
+#include "memory.h"
+#include "spinlock.h"
+#include <string.h>
+
+static buddy_allocator_t buddy;
+static spinlock_t buddy_lock = SPINLOCK_INIT;   // 빈 리스트와 참조 카운트 보호 (모든 CPU 공유)
+
+// 최대 차수 블록 크기 (4MB)
+#define BUDDY_MAX_BLOCK_SIZE (PAGE_SIZE << BUDDY_MAX_ORDER)
+
+// 기준 주소로부터의 블록 인덱스
+static uint32_t block_index(uint32_t addr, uint32_t order) {
+    return (addr - buddy.base) >> (12 + order);
+}
+
+// 프레임 참조 카운트 위치 (관리 범위 밖이면 NULL)
+static uint16_t* page_ref(uint32_t addr) {
+    if (!buddy.page_refs || addr < buddy.base || addr >= buddy.end) return NULL;
+    return &buddy.page_refs[(addr - buddy.base) >> 12];
+}
+
+static int bitmap_test(uint32_t addr, uint32_t order) {
+    uint32_t index = block_index(addr, order);
+    return (buddy.free_area[order].bitmap[index >> 5] >> (index & 31)) & 1;
+}
+
+static void bitmap_set(uint32_t addr, uint32_t order) {
+    uint32_t index = block_index(addr, order);
+    buddy.free_area[order].bitmap[index >> 5] |= 1u << (index & 31);
+}
+
+static void bitmap_clear(uint32_t addr, uint32_t order) {
+    uint32_t index = block_index(addr, order);
+    buddy.free_area[order].bitmap[index >> 5] &= ~(1u << (index & 31));
+}
+
+// 빈 블록 등록
+static void free_area_add(uint32_t addr, uint32_t order) {
+    free_area_t* area = &buddy.free_area[order];
+    buddy_block_t* block = (buddy_block_t*)addr;
+    
+    block->prev = NULL;
+    block->next = area->free_list;
+    if (block->next) {
+        block->next->prev = block;
+    }
+    area->free_list = block;
+    area->free_count++;
+    bitmap_set(addr, order);
+}
+
+// 빈 블록 제거
+static void free_area_remove(uint32_t addr, uint32_t order) {
+    free_area_t* area = &buddy.free_area[order];
+    buddy_block_t* block = (buddy_block_t*)addr;
+    
+    if (block->prev) {
+        block->prev->next = block->next;
+    } else {
+        area->free_list = block->next;
+    }
+    if (block->next) {
+        block->next->prev = block->prev;
+    }
+    area->free_count--;
+    bitmap_clear(addr, order);
+}
+
+// 버디 할당기 초기화 (관리 범위 전체에 대한 차수별 비트맵을 힙에 할당)
+void buddy_init(uint32_t start_addr, uint32_t end_addr) {
+    memset(&buddy, 0, sizeof(buddy));
+    
+    end_addr &= ~(PAGE_SIZE - 1);
+    buddy.base = start_addr & ~(BUDDY_MAX_BLOCK_SIZE - 1);
+    buddy.end = end_addr;
+    
+    uint32_t span_pages = (end_addr - buddy.base) >> 12;
+    for (uint32_t order = 0; order < BUDDY_ORDER_COUNT; order++) {
+        uint32_t blocks = (span_pages >> order) + 1;
+        uint32_t bytes = ((blocks + 31) / 32) * sizeof(uint32_t);
+        
+        buddy.free_area[order].bitmap = (uint32_t*)kmalloc(bytes);
+        if (buddy.free_area[order].bitmap) {
+            memset(buddy.free_area[order].bitmap, 0, bytes);
+        }
+    }
+    
+    buddy.page_refs = (uint16_t*)kmalloc(span_pages * sizeof(uint16_t));
+    if (buddy.page_refs) {
+        memset(buddy.page_refs, 0, span_pages * sizeof(uint16_t));
+    }
+}
+
+// 사용 가능한 물리 메모리 구간 등록 (정렬이 허용하는 가장 큰 블록 단위로)
+void buddy_add_range(uint32_t start_addr, uint32_t end_addr) {
+    uint32_t addr = (start_addr + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    
+    end_addr &= ~(PAGE_SIZE - 1);
+    if (addr < buddy.base) addr = buddy.base;
+    if (end_addr > buddy.end) end_addr = buddy.end;
+    
+    while (addr < end_addr) {
+        uint32_t order = BUDDY_MAX_ORDER;
+        while (order > 0 &&
+               (((addr - buddy.base) & ((PAGE_SIZE << order) - 1)) ||
+                addr + (PAGE_SIZE << order) > end_addr)) {
+            order--;
+        }
+        
+        // 이웃 구간의 빈 블록과 병합될 수 있도록 해제 경로로 등록
+        buddy.total_pages += 1u << order;
+        page_free((void*)addr, order);
+        addr += PAGE_SIZE << order;
+    }
+}
+
+// 2^order 개의 연속된 페이지 할당
+void* page_alloc(uint32_t order) {
+    if (order > BUDDY_MAX_ORDER) return NULL;
+    
+    uint32_t flags = spin_lock_irqsave(&buddy_lock);
+    
+    // 요청 차수 이상에서 빈 블록 찾기
+    uint32_t current = order;
+    while (current < BUDDY_ORDER_COUNT && !buddy.free_area[current].free_list) {
+        current++;
+    }
+    if (current >= BUDDY_ORDER_COUNT) {
+        spin_unlock_irqrestore(&buddy_lock, flags);
+        return NULL; // 메모리 부족
+    }
+    
+    uint32_t addr = (uint32_t)buddy.free_area[current].free_list;
+    free_area_remove(addr, current);
+    
+    // 큰 블록을 반으로 나누며 남는 버디를 아래 차수에 등록
+    while (current > order) {
+        current--;
+        free_area_add(addr + (PAGE_SIZE << current), current);
+    }
+    
+    buddy.free_pages -= 1u << order;
+    
+    uint16_t* ref = page_ref(addr);
+    if (ref) *ref = 1;
+    
+    spin_unlock_irqrestore(&buddy_lock, flags);
+    return (void*)addr;
+}
+
+// 블록 반환 (빈 버디와 반복 병합, buddy_lock을 잡은 상태에서 호출)
+static void buddy_free(uint32_t addr, uint32_t order) {
+    buddy.free_pages += 1u << order;
+    
+    uint16_t* ref = page_ref(addr);
+    if (ref) *ref = 0;
+    
+    while (order < BUDDY_MAX_ORDER) {
+        uint32_t buddy_addr = buddy.base + ((addr - buddy.base) ^ (PAGE_SIZE << order));
+        
+        if (buddy_addr + (PAGE_SIZE << order) > buddy.end || !bitmap_test(buddy_addr, order)) {
+            break;
+        }
+        
+        free_area_remove(buddy_addr, order);
+        if (buddy_addr < addr) {
+            addr = buddy_addr;
+        }
+        order++;
+    }
+    
+    free_area_add(addr, order);
+}
+
+// 페이지 해제
+void page_free(void* page, uint32_t order) {
+    uint32_t addr = (uint32_t)page;
+    
+    if (!page || order > BUDDY_MAX_ORDER) return;
+    if (addr < buddy.base || addr >= buddy.end || (addr & (PAGE_SIZE - 1))) return;
+    
+    uint32_t flags = spin_lock_irqsave(&buddy_lock);
+    buddy_free(addr, order);
+    spin_unlock_irqrestore(&buddy_lock, flags);
+}
+
+// 프레임 공유 (참조 카운트 증가)
+void page_get(void* page) {
+    uint32_t flags = spin_lock_irqsave(&buddy_lock);
+    uint16_t* ref = page_ref((uint32_t)page);
+    if (ref && *ref < 0xFFFF) {
+        (*ref)++;
+    }
+    spin_unlock_irqrestore(&buddy_lock, flags);
+}
+
+// 프레임 공유 해제 (마지막 참조가 사라지면 해제, 감소와 해제는 한 번의 잠금 안에서)
+void page_put(void* page) {
+    uint32_t addr = (uint32_t)page;
+    if (!page || addr < buddy.base || addr >= buddy.end || (addr & (PAGE_SIZE - 1))) return;
+    
+    uint32_t flags = spin_lock_irqsave(&buddy_lock);
+    uint16_t* ref = page_ref(addr);
+    
+    // 이미 해제된 프레임 (중복 해제)은 무시해야 빈 블록 리스트가 망가지지 않음
+    if (ref && *ref == 0) {
+        spin_unlock_irqrestore(&buddy_lock, flags);
+        return;
+    }
+    
+    if (!ref || --(*ref) == 0) {
+        buddy_free(addr, 0);
+    }
+    spin_unlock_irqrestore(&buddy_lock, flags);
+}
+
+uint32_t page_ref_count(void* page) {
+    uint16_t* ref = page_ref((uint32_t)page);
+    return ref ? *ref : 0;
+}
+
+uint32_t buddy_get_total_pages(void) {
+    return buddy.total_pages;
+}
+
+uint32_t buddy_get_free_pages(void) {
+    return buddy.free_pages;
+}
+
+// 버디 할당기 통계 출력
+void buddy_dump_stats(void) {
+    // 간단한 통계 출력 (실제 구현에서는 콘솔 출력 함수 필요)
+    uint32_t free_blocks[BUDDY_ORDER_COUNT];
+    
+    for (uint32_t order = 0; order < BUDDY_ORDER_COUNT; order++) {
+        free_blocks[order] = buddy.free_area[order].free_count;
+    }
+    
+    (void)free_blocks;
+}
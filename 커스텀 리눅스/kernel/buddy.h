@@ -0,0 +1,46 @@
+#ifndef BUDDY_H
+#define BUDDY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 버디 할당기 차수 (0차 = 4KB, 10차 = 4MB)
+#define BUDDY_MAX_ORDER 10
+#define BUDDY_ORDER_COUNT (BUDDY_MAX_ORDER + 1)
+
+// 빈 블록 리스트 노드 (빈 페이지 프레임 안에 저장)
+typedef struct buddy_block {
+    struct buddy_block* next;
+    struct buddy_block* prev;
+} buddy_block_t;
+
+// 차수별 빈 블록 영역
+typedef struct free_area {
+    buddy_block_t* free_list;       // 이 차수의 빈 블록 리스트
+    uint32_t* bitmap;               // 블록 시작 위치별 빈 상태 비트맵
+    uint32_t free_count;            // 이 차수의 빈 블록 수
+} free_area_t;
+
+// 버디 할당기 구조체
+typedef struct buddy_allocator {
+    uint32_t base;                  // 관리 기준 주소 (최대 차수 블록 크기로 정렬)
+    uint32_t end;                   // 관리 영역 끝
+    uint32_t total_pages;           // 할당 가능한 전체 페이지 수
+    uint32_t free_pages;            // 빈 페이지 수
+    uint16_t* page_refs;            // 프레임별 참조 카운트 (공유 페이지용)
+    free_area_t free_area[BUDDY_ORDER_COUNT];
+} buddy_allocator_t;
+
+// 버디 할당기 함수들
+void buddy_init(uint32_t start_addr, uint32_t end_addr);
+void buddy_add_range(uint32_t start_addr, uint32_t end_addr);
+void* page_alloc(uint32_t order);
+void page_free(void* page, uint32_t order);
+void page_get(void* page);
+void page_put(void* page);
+uint32_t page_ref_count(void* page);
+uint32_t buddy_get_total_pages(void);
+uint32_t buddy_get_free_pages(void);
+void buddy_dump_stats(void);
+
+#endif // BUDDY_H
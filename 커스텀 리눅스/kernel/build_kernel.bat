@@ -21,13 +21,35 @@ echo 커널 컴파일 중...
 
 REM 커널 소스 파일들 컴파일
 gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o memory.o memory.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o buddy.o buddy.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o slab.o slab.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o rbtree.o rbtree.c
 gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o interrupt.o interrupt.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o irqstat.o irqstat.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o softirq.o softirq.c
+nasm -f elf32 -o isr.o isr.asm
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o pit.o pit.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o tsc.o tsc.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o gdt.o gdt.c
 gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o scheduler.o scheduler.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o wait.o wait.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o sync.o sync.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o workqueue.o workqueue.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o futex.o futex.c
+nasm -f elf32 -o switch.o switch.asm
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o fpu.o fpu.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o timer.o timer.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o acpi.o acpi.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o apic.o apic.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o ioapic.o ioapic.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o smp.o smp.c
+nasm -f elf32 -o ap_boot.o ap_boot.asm
 gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o filesystem.o filesystem.c
+gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o procfs.o procfs.c
 gcc -m32 -c -fno-pie -fno-stack-protector -nostdlib -nostdinc -fno-builtin -fno-pic -mno-red-zone -ffreestanding -std=c99 -Wall -Wextra -O2 -I. -o kernel.o kernel.c
 
 echo 커널 링크 중...
-ld -m elf_i386 -T kernel.ld -o kernel.bin memory.o interrupt.o scheduler.o filesystem.o kernel.o
+ld -m elf_i386 -T kernel.ld -o kernel.bin memory.o buddy.o slab.o rbtree.o interrupt.o irqstat.o softirq.o isr.o pit.o tsc.o gdt.o scheduler.o wait.o sync.o workqueue.o futex.o switch.o fpu.o timer.o acpi.o apic.o ioapic.o smp.o ap_boot.o filesystem.o procfs.o kernel.o
 
 echo 커널 빌드 완료!
 echo 생성된 파일:
@@ -1,5 +1,7 @@
 #include "filesystem.h"
 #include "memory.h"
+#include "slab.h"
+#include "procfs.h"
 #include <string.h>
 
 #define MAX_FILES 1024
@@ -9,6 +11,7 @@
 // 전역 변수들
 static fs_file_t file_table[MAX_FILES];
 static mount_point_t* mount_points = NULL;
+static kmem_cache_t* mount_point_cache = NULL;
 static filesystem_t* registered_fs[MAX_FILE_SYSTEMS];
 static int next_fd = 3; // 0, 1, 2는 표준 입출력용
 static char current_working_directory[256] = "/";
@@ -33,6 +36,9 @@ int fs_init(void) {
     
     // 마운트 포인트 초기화
     mount_points = NULL;
+    if (!mount_point_cache) {
+        mount_point_cache = kmem_cache_create("mount_point", sizeof(mount_point_t), 0, NULL);
+    }
     
     // 등록된 파일 시스템 초기화
     memset(registered_fs, 0, sizeof(registered_fs));
@@ -64,7 +70,7 @@ int fs_unregister(const char* name) {
 
 // 마운트 포인트 추가
 int fs_add_mount_point(const char* device, const char* mount_point, filesystem_t* fs) {
-    mount_point_t* new_mount = (mount_point_t*)kmalloc(sizeof(mount_point_t));
+    mount_point_t* new_mount = (mount_point_t*)kmem_cache_alloc(mount_point_cache);
     if (!new_mount) return -1;
     
     strncpy(new_mount->device, device, 255);
@@ -91,7 +97,7 @@ int fs_remove_mount_point(const char* mount_point) {
             } else {
                 mount_points = current->next;
             }
-            kfree(current);
+            kmem_cache_free(mount_point_cache, current);
             return 0;
         }
         prev = current;
@@ -140,6 +146,10 @@ int fs_unmount(const char* mount_point) {
 
 // 파일 열기
 int fs_open(const char* path, fs_open_mode_t mode) {
+    // /proc 가상 파일은 읽기 전용
+    int proc = proc_lookup(path);
+    if (proc >= 0 && (mode & ~FS_OPEN_READ)) return -1;
+    
     // 빈 파일 디스크립터 찾기
     int fd = -1;
     for (int i = 0; i < MAX_FILES; i++) {
@@ -157,6 +167,7 @@ int fs_open(const char* path, fs_open_mode_t mode) {
     file_table[fd].offset = 0;
     file_table[fd].mode = mode;
     file_table[fd].ref_count = 1;
+    file_table[fd].proc = proc >= 0 ? (uint32_t)proc + 1 : 0;
     
     return file_table[fd].fd;
 }
@@ -179,6 +190,17 @@ int fs_close(int fd) {
 
 // 파일 읽기
 ssize_t fs_read(int fd, void* buffer, size_t size) {
+    // /proc 가상 파일은 읽을 때마다 내용을 새로 만듦
+    for (int i = 0; i < MAX_FILES; i++) {
+        if (file_table[i].ref_count && file_table[i].fd == (uint32_t)fd && file_table[i].proc) {
+            int count = proc_read(file_table[i].proc - 1, file_table[i].offset, buffer, size);
+            if (count > 0) {
+                file_table[i].offset += count;
+            }
+            return count;
+        }
+    }
+    
     // 간단한 구현: 실제로는 파일 시스템별로 구현
     (void)fd;
     (void)buffer;
@@ -57,6 +57,7 @@ typedef struct {
     uint32_t offset;         // 현재 오프셋
     fs_open_mode_t mode;     // 열기 모드
     uint32_t ref_count;      // 참조 카운트
+    uint32_t proc;           // /proc 항목 번호 + 1 (0이면 일반 파일)
 } fs_file_t;
 
 // 디렉토리 엔트리 구조체
@@ -0,0 +1,179 @@
+#include "fpu.h"
+#include "slab.h"
+#include "interrupt.h"
+#include "smp.h"
+#include <string.h>
+
+// CR0/CR4 비트와 CPUID 기능 비트
+#define CR0_MP 0x2
+#define CR0_EM 0x4
+#define CR0_TS 0x8
+#define CR0_NE 0x20
+#define CR4_OSFXSR 0x200
+#define CR4_OSXMMEXCPT 0x400
+#define CPUID_FEATURE_FXSR (1 << 24)
+
+static kmem_cache_t* fpu_state_cache = NULL;
+static uint32_t fxsr_supported = 0;
+
+static void fpu_set_ts(void) {
+    uint32_t cr0;
+    __asm__ volatile("mov %%cr0, %0" : "=r" (cr0));
+    if (!(cr0 & CR0_TS)) {
+        __asm__ volatile("mov %0, %%cr0" : : "r" (cr0 | CR0_TS));
+    }
+}
+
+static void fpu_clear_ts(void) {
+    __asm__ volatile("clts");
+}
+
+// FPU 상태 저장 (FNSAVE는 저장 후 FPU를 초기화함)
+static void fpu_save(void* state) {
+    if (fxsr_supported) {
+        __asm__ volatile("fxsave (%0)" : : "r" (state) : "memory");
+    } else {
+        __asm__ volatile("fnsave (%0)" : : "r" (state) : "memory");
+    }
+}
+
+static void fpu_restore(void* state) {
+    if (fxsr_supported) {
+        __asm__ volatile("fxrstor (%0)" : : "r" (state) : "memory");
+    } else {
+        __asm__ volatile("frstor (%0)" : : "r" (state) : "memory");
+    }
+}
+
+// FPU 초기화 (공통 설정 후 BSP의 FPU 활성화)
+void fpu_init(void) {
+    fpu_state_cache = kmem_cache_create("fpu_state", FPU_STATE_SIZE, FPU_STATE_ALIGN, NULL);
+    
+    // FXSAVE/FXRSTOR 지원 확인
+    uint32_t eax, ebx, ecx, edx;
+    __asm__ volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (1));
+    fxsr_supported = (edx & CPUID_FEATURE_FXSR) != 0;
+    
+    set_exception_handler(EXCEPTION_DEVICE_NOT_AVAILABLE, fpu_trap_handler);
+    fpu_init_cpu();
+}
+
+// 이 CPU의 FPU 활성화 (AP는 부팅 직후 호출)
+void fpu_init_cpu(void) {
+    // FPU 사용 (에뮬레이션 없음, 네이티브 예외 보고)
+    uint32_t cr0;
+    __asm__ volatile("mov %%cr0, %0" : "=r" (cr0));
+    cr0 = (cr0 & ~(CR0_EM | CR0_TS)) | CR0_MP | CR0_NE;
+    __asm__ volatile("mov %0, %%cr0" : : "r" (cr0));
+    
+    if (fxsr_supported) {
+        uint32_t cr4;
+        __asm__ volatile("mov %%cr4, %0" : "=r" (cr4));
+        __asm__ volatile("mov %0, %%cr4" : : "r" (cr4 | CR4_OSFXSR | CR4_OSXMMEXCPT));
+    }
+    
+    __asm__ volatile("fninit");
+    
+    // 첫 FPU 명령에서 #NM이 발생하도록 TS 설정
+    fpu_set_ts();
+}
+
+// 이번 실행 중에 사용한 FPU 상태를 메모리에 저장 (다른 CPU로 옮겨 가도 복원할 수 있도록)
+static void fpu_save_used(cpu_t* cpu, process_t* process) {
+    if (!cpu->fpu_used) return;
+    cpu->fpu_used = 0;
+    
+    fpu_clear_ts();
+    fpu_save(process->fpu_state);
+    
+    // FNSAVE는 FPU를 초기화하므로 레지스터의 상태는 더 이상 이 프로세스 것이 아님
+    if (!fxsr_supported) {
+        cpu->fpu_owner = NULL;
+    }
+}
+
+// 전환 시 사용한 상태만 저장하고 TS 설정 (복원은 다음 사용 시 #NM에서)
+void fpu_switch(process_t* prev) {
+    cpu_t* cpu = smp_this_cpu();
+    
+    if (prev && prev == cpu->fpu_owner) {
+        fpu_save_used(cpu, prev);
+    }
+    cpu->fpu_used = 0;
+    fpu_set_ts();
+}
+
+// #NM 처리 (레지스터에 최신 상태가 없으면 메모리에서 복원)
+void fpu_trap_handler(interrupt_context_t* context) {
+    (void)context;
+    cpu_t* cpu = smp_this_cpu();
+    process_t* current = cpu->sched.current_process;
+    
+    fpu_clear_ts();
+    
+    // 이 CPU에서 마지막으로 불러온 뒤 다른 CPU에서 실행되지 않았으면 레지스터가 그대로 유효
+    if (current && cpu->fpu_owner == current && current->fpu_cpu == cpu->id) {
+        cpu->fpu_used = 1;
+        return;
+    }
+    
+    // 이전 소유자의 상태는 전환할 때 이미 저장됨
+    cpu->fpu_owner = NULL;
+    
+    // 유휴 문맥은 상태를 가지지 않음
+    if (!current) return;
+    
+    if (current->fpu_state) {
+        fpu_restore(current->fpu_state);
+    } else {
+        // 처음 사용하는 프로세스는 초기 상태로 시작
+        current->fpu_state = kmem_cache_alloc(fpu_state_cache);
+        __asm__ volatile("fninit");
+        if (!current->fpu_state) return; // 메모리 부족 (상태를 저장하지 못함)
+    }
+    
+    cpu->fpu_owner = current;
+    cpu->fpu_used = 1;
+    current->fpu_cpu = cpu->id;
+}
+
+// 부모의 FPU 상태 복제
+int fpu_fork(process_t* child, process_t* parent) {
+    child->fpu_state = NULL;
+    child->fpu_cpu = SMP_NO_CPU;
+    if (!parent->fpu_state) return 0;
+    
+    child->fpu_state = kmem_cache_alloc(fpu_state_cache);
+    if (!child->fpu_state) return -1;
+    
+    // 부모 상태가 레지스터에만 있으면 먼저 저장
+    uint32_t flags = irq_save();
+    cpu_t* cpu = smp_this_cpu();
+    if (parent == cpu->fpu_owner && cpu->fpu_used) {
+        fpu_save_used(cpu, parent);
+        if (!fxsr_supported) {
+            // FNSAVE로 초기화된 레지스터를 되돌리고 계속 사용
+            fpu_restore(parent->fpu_state);
+            cpu->fpu_owner = parent;
+        }
+        cpu->fpu_used = 1;
+    }
+    irq_restore(flags);
+    
+    memcpy(child->fpu_state, parent->fpu_state, FPU_STATE_SIZE);
+    return 0;
+}
+
+// 프로세스 종료 시 FPU 상태 해제
+void fpu_release(process_t* process) {
+    for (uint32_t i = 0; i < smp_cpu_count(); i++) {
+        if (smp_cpus[i].fpu_owner == process) {
+            smp_cpus[i].fpu_owner = NULL;
+        }
+    }
+    
+    if (process->fpu_state) {
+        kmem_cache_free(fpu_state_cache, process->fpu_state);
+        process->fpu_state = NULL;
+    }
+}
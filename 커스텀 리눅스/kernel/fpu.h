@@ -0,0 +1,21 @@
+#ifndef FPU_H
+#define FPU_H
+
+#include <stdint.h>
+#include "scheduler.h"
+
+struct interrupt_context;
+
+// FXSAVE 영역 크기와 정렬
+#define FPU_STATE_SIZE 512
+#define FPU_STATE_ALIGN 16
+
+// FPU/SSE 상태 관리 함수들 (복원은 첫 사용 시 #NM 트랩에서, 저장은 사용한 경우에만 전환 시)
+void fpu_init(void);
+void fpu_init_cpu(void);
+void fpu_switch(process_t* prev);
+void fpu_trap_handler(struct interrupt_context* context);
+int fpu_fork(process_t* child, process_t* parent);
+void fpu_release(process_t* process);
+
+#endif // FPU_H
@@ -0,0 +1,65 @@
+#include "futex.h"
+#include "wait.h"
+#include "scheduler.h"
+#include "memory.h"
+
+// 대기 큐 해시 (여러 단어가 한 칸을 나눠 쓰고 깨우기는 키로 고름)
+#define FUTEX_HASH_BITS 6
+#define FUTEX_HASH_SIZE (1 << FUTEX_HASH_BITS)
+
+static wait_queue_t futex_queues[FUTEX_HASH_SIZE]; // 0으로 채워져 있으면 빈 큐
+
+static wait_queue_t* futex_queue(uint32_t key) {
+    return &futex_queues[((key >> 2) * 0x9E3779B1u) >> (32 - FUTEX_HASH_BITS)];
+}
+
+// 현재 프로세스의 영역 안에 정렬된 사용자 단어인지
+static int futex_valid(uint32_t* addr) {
+    process_t* current = process_get_current();
+    return current && !((uint32_t)addr & 3) && vm_area_find(current->vm_areas, (uint32_t)addr);
+}
+
+// 단어의 키 (물리 주소, 같은 프레임을 공유하는 다른 주소 공간과도 일치, 매핑되지 않았으면 0)
+static uint32_t futex_key(uint32_t* addr) {
+    return virtual_to_physical(page_directory_current(), (uint32_t)addr);
+}
+
+// *addr가 val과 같으면 futex_wake까지 잠듦 (timeout 틱이 지나면 깨어남, 0이면 기한 없음)
+int futex_wait(uint32_t* addr, uint32_t val, uint32_t timeout) {
+    volatile uint32_t* word = addr;
+    if (!futex_valid(addr)) return FUTEX_EAGAIN;
+    
+    // 먼저 읽어서 값이 다르면 바로 돌아가고, 같으면 첫 접근의 페이지 폴트로 프레임을 매핑해 둠
+    if (*word != val) return FUTEX_EAGAIN;
+    
+    uint32_t key = futex_key(addr);
+    if (!key) return FUTEX_EAGAIN;
+    
+    // 값을 바꾸고 깨우는 쪽은 같은 큐 잠금을 기다리므로 확인과 잠들기 사이의 깨우기를 놓치지 않음
+    wait_queue_t* wq = futex_queue(key);
+    uint32_t flags = spin_lock_irqsave(&wq->lock);
+    if (*word != val) {
+        spin_unlock_irqrestore(&wq->lock, flags);
+        return FUTEX_EAGAIN;
+    }
+    
+    int result = wait_queue_sleep_locked(wq, (const void*)key, WAIT_EXCLUSIVE, timeout);
+    spin_unlock_irqrestore(&wq->lock, flags);
+    
+    return result < 0 ? FUTEX_ETIMEDOUT : FUTEX_WOKEN;
+}
+
+// addr을 기다리는 프로세스를 count개까지 깨움 (깨운 수)
+int futex_wake(uint32_t* addr, uint32_t count) {
+    if (!futex_valid(addr) || !count) return 0;
+    
+    uint32_t key = futex_key(addr);
+    if (!key) return 0; // 매핑되지 않은 단어는 기다리는 프로세스도 없음
+    
+    wait_queue_t* wq = futex_queue(key);
+    uint32_t flags = spin_lock_irqsave(&wq->lock);
+    uint32_t woken = wake_up_locked(wq, (const void*)key, count);
+    spin_unlock_irqrestore(&wq->lock, flags);
+    
+    return (int)woken;
+}
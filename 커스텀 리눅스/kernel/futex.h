@@ -0,0 +1,21 @@
+#ifndef FUTEX_H
+#define FUTEX_H
+
+#include <stdint.h>
+
+// 사용자 공간 잠금용 대기 (경합이 없으면 사용자 공간의 원자적 연산만으로 끝나고
+// 경합할 때만 시스템 콜로 그 단어를 기다리는 프로세스를 재우고 깨움)
+
+// 연산 (시스템 콜 op 인자)
+#define FUTEX_WAIT 0                // *addr == val이면 깨울 때까지 잠듦
+#define FUTEX_WAKE 1                // addr을 기다리는 프로세스를 val개까지 깨움
+
+// futex_wait 결과
+#define FUTEX_WOKEN 0               // futex_wake로 깨어남
+#define FUTEX_EAGAIN (-1)           // 잘못된 주소이거나 값이 이미 바뀜 (다시 확인)
+#define FUTEX_ETIMEDOUT (-2)        // 시간 초과
+
+int futex_wait(uint32_t* addr, uint32_t val, uint32_t timeout);
+int futex_wake(uint32_t* addr, uint32_t count);
+
+#endif // FUTEX_H
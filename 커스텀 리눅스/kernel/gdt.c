@@ -0,0 +1,99 @@
+#include "gdt.h"
+#include <string.h>
+
+// SYSENTER MSR과 CPUID 기능 비트
+#define MSR_SYSENTER_CS 0x174
+#define MSR_SYSENTER_ESP 0x175
+#define MSR_SYSENTER_EIP 0x176
+#define CPUID_FEATURE_SEP (1 << 11)
+
+// SYSENTER 직후 커널 스택으로 바꾸기 전까지 쓰는 CPU별 임시 스택
+// (MSR이 esp0를 가리키고 진입 스텁이 그 값으로 스택을 바꿈, 그 사이의 NMI나 단일 단계 트랩은 stack에서 처리)
+typedef struct {
+    uint32_t stack[256];
+    uint32_t esp0;                  // 이 CPU TSS의 esp0 복사본
+} sysenter_stack_t;
+
+static gdt_entry_t gdt[GDT_ENTRY_COUNT];
+static gdtr_t gdtr;
+static tss_t tss[GDT_TSS_COUNT];
+static sysenter_stack_t sysenter_stacks[GDT_TSS_COUNT];
+static int sysenter_supported = 0;
+
+extern void sysenter_entry(void);   // isr.asm
+
+static void wrmsr(uint32_t msr, uint32_t value) {
+    __asm__ volatile("wrmsr" : : "c" (msr), "a" (value), "d" (0));
+}
+
+// 디스크립터 설정
+static void gdt_set_entry(int num, uint32_t base, uint32_t limit, uint8_t access, uint8_t granularity) {
+    gdt[num].base_low = base & 0xFFFF;
+    gdt[num].base_middle = (base >> 16) & 0xFF;
+    gdt[num].base_high = (base >> 24) & 0xFF;
+    gdt[num].limit_low = limit & 0xFFFF;
+    gdt[num].granularity = ((limit >> 16) & 0x0F) | (granularity & 0xF0);
+    gdt[num].access = access;
+}
+
+// GDT 초기화 (Stage 2의 임시 GDT를 커널/사용자 세그먼트와 TSS로 교체)
+void gdt_init(void) {
+    gdt_set_entry(0, 0, 0, 0, 0);                    // Null 디스크립터
+    gdt_set_entry(1, 0, 0xFFFFFFFF, 0x9A, 0xCF);     // 커널 코드
+    gdt_set_entry(2, 0, 0xFFFFFFFF, 0x92, 0xCF);     // 커널 데이터
+    gdt_set_entry(3, 0, 0xFFFFFFFF, 0xFA, 0xCF);     // 사용자 코드 (DPL 3)
+    gdt_set_entry(4, 0, 0xFFFFFFFF, 0xF2, 0xCF);     // 사용자 데이터 (DPL 3)
+    
+    // CPU별 TSS (사용 중이 아닌 32비트 TSS)
+    memset(tss, 0, sizeof(tss));
+    for (int i = 0; i < GDT_TSS_COUNT; i++) {
+        tss[i].ss0 = GDT_KERNEL_DATA;
+        tss[i].iomap_base = sizeof(tss_t); // I/O 권한 비트맵 없음
+        gdt_set_entry(5 + i, (uint32_t)&tss[i], sizeof(tss_t) - 1, 0x89, 0x00);
+    }
+    
+    gdtr.limit = sizeof(gdt) - 1;
+    gdtr.base = (uint32_t)&gdt;
+    
+    // SYSENTER/SYSEXIT 지원 확인 (초기 Pentium Pro는 SEP 비트를 켜 두지만 명령을 지원하지 않음)
+    uint32_t eax, ebx, ecx, edx;
+    __asm__ volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (1));
+    uint32_t family = (eax >> 8) & 0xF;
+    uint32_t model = (eax >> 4) & 0xF;
+    uint32_t stepping = eax & 0xF;
+    sysenter_supported = (edx & CPUID_FEATURE_SEP) && !(family == 6 && model < 3 && stepping < 3);
+    
+    gdt_load(0);
+}
+
+// GDT와 이 CPU의 TSS 로드 (AP는 부팅 직후 자기 번호로 호출)
+void gdt_load(uint32_t cpu) {
+    // GDT 로드 후 세그먼트 레지스터 다시 설정
+    __asm__ volatile("lgdt %0" : : "m" (gdtr));
+    __asm__ volatile(
+        "ljmp %0, $1f\n"
+        "1:\n"
+        "mov %1, %%ax\n"
+        "mov %%ax, %%ds\n"
+        "mov %%ax, %%es\n"
+        "mov %%ax, %%fs\n"
+        "mov %%ax, %%gs\n"
+        "mov %%ax, %%ss\n"
+        : : "i" (GDT_KERNEL_CODE), "i" (GDT_KERNEL_DATA) : "eax", "memory");
+    
+    // TSS 로드 (smp_cpu_id는 TR에서 CPU 번호를 얻음)
+    __asm__ volatile("ltr %%ax" : : "a" (GDT_TSS + cpu * 8));
+    
+    // SYSENTER는 커널 코드/데이터, SYSEXIT는 그 뒤의 사용자 코드/데이터 셀렉터를 쓰므로 GDT 순서가 맞아야 함
+    if (sysenter_supported) {
+        wrmsr(MSR_SYSENTER_CS, GDT_KERNEL_CODE);
+        wrmsr(MSR_SYSENTER_ESP, (uint32_t)&sysenter_stacks[cpu].esp0);
+        wrmsr(MSR_SYSENTER_EIP, (uint32_t)sysenter_entry);
+    }
+}
+
+// 사용자 모드에서 진입할 때 사용할 커널 스택 설정 (인터럽트는 TSS에서, SYSENTER는 복사본에서 읽음)
+void tss_set_kernel_stack(uint32_t cpu, uint32_t esp0) {
+    tss[cpu].esp0 = esp0;
+    sysenter_stacks[cpu].esp0 = esp0;
+}
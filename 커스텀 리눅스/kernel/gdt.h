@@ -0,0 +1,53 @@
+#ifndef GDT_H
+#define GDT_H
+
+#include <stdint.h>
+
+// 세그먼트 셀렉터
+#define GDT_KERNEL_CODE 0x08
+#define GDT_KERNEL_DATA 0x10
+#define GDT_USER_CODE 0x18
+#define GDT_USER_DATA 0x20
+#define GDT_TSS 0x28                // 첫 CPU의 TSS (CPU마다 8씩 증가)
+#define GDT_TSS_COUNT 16            // CPU마다 TSS 하나 (esp0와 사용 중 비트가 CPU별)
+#define GDT_ENTRY_COUNT (5 + GDT_TSS_COUNT)
+
+// GDT 디스크립터 구조체
+typedef struct {
+    uint16_t limit_low;
+    uint16_t base_low;
+    uint8_t base_middle;
+    uint8_t access;
+    uint8_t granularity;
+    uint8_t base_high;
+} __attribute__((packed)) gdt_entry_t;
+
+// GDTR 구조체
+typedef struct {
+    uint16_t limit;
+    uint32_t base;
+} __attribute__((packed)) gdtr_t;
+
+// 태스크 상태 세그먼트 (사용자 모드에서 진입할 때 커널 스택 제공)
+typedef struct {
+    uint32_t prev_tss;
+    uint32_t esp0;                  // 커널 스택 포인터
+    uint32_t ss0;                   // 커널 스택 세그먼트
+    uint32_t esp1, ss1;
+    uint32_t esp2, ss2;
+    uint32_t cr3;
+    uint32_t eip, eflags;
+    uint32_t eax, ecx, edx, ebx;
+    uint32_t esp, ebp, esi, edi;
+    uint32_t es, cs, ss, ds, fs, gs;
+    uint32_t ldt;
+    uint16_t trap;
+    uint16_t iomap_base;
+} __attribute__((packed)) tss_t;
+
+// GDT 관련 함수들
+void gdt_init(void);
+void gdt_load(uint32_t cpu);
+void tss_set_kernel_stack(uint32_t cpu, uint32_t esp0);
+
+#endif // GDT_H
@@ -1,24 +1,71 @@
 #include "interrupt.h"
+#include "memory.h"
+#include "scheduler.h"
+#include "spinlock.h"
+#include "irqstat.h"
+#include "softirq.h"
 #include <string.h>
+#include <stddef.h>
 
 // IDT 엔트리 배열
 static idt_entry_t idt[256];
 static idtr_t idtr;
 
+// IDT 게이트 종류
+#define IDT_GATE_KERNEL 0x8E        // 32비트 인터럽트 게이트, DPL 0
+#define IDT_GATE_USER 0xEE          // 32비트 인터럽트 게이트, DPL 3 (int 명령으로 호출 가능)
+
+// isr.asm의 벡터별 진입 스텁 (빠른 경로는 IRQ0부터)
+extern uint32_t isr_stub_table[256];
+extern uint32_t isr_fast_table[256 - IRQ0];
+
 // 인터럽트 핸들러 배열
 static interrupt_handler_t interrupt_handlers[256];
-static interrupt_handler_t irq_handlers[16];
+static exception_handler_t exception_handlers[32];
+static interrupt_handler_t irq_handlers[IRQ_LINES];
+fast_interrupt_handler_t fast_interrupt_handlers[256]; // isr.asm의 빠른 경로가 바로 호출
 
 // 시스템 콜 핸들러 배열
 static syscall_handler_t syscall_handlers[SYSCALL_MAX];
 
+// 8259 PIC 포트
+#define PIC_MASTER_COMMAND 0x20
+#define PIC_MASTER_DATA 0x21
+#define PIC_SLAVE_COMMAND 0xA0
+#define PIC_SLAVE_DATA 0xA1
+#define PIC_EOI 0x20
+#define PIC_CASCADE_IRQ 2
+
+// 현재 인터럽트 컨트롤러와 켜 둔 IRQ (컨트롤러를 바꿀 때 다시 켬)
+static const irq_chip_t* irq_chip = &pic_chip;
+static uint32_t irq_enabled = 0;
+static spinlock_t irq_chip_lock = SPINLOCK_INIT;   // 마스크 사본과 컨트롤러 레지스터 보호
+
+// PIC 마스크 레지스터 사본 (비트 0~7은 마스터, 8~15는 슬레이브, 1이면 마스킹)
+static uint16_t pic_imr = 0xFFFF;
+
+// 인터럽트 게이트 설정
+static void set_idt_gate(uint8_t num, uint32_t handler, uint8_t flags) {
+    idt[num].offset_low = handler & 0xFFFF;
+    idt[num].selector = 0x08; // 커널 코드 세그먼트
+    idt[num].zero = 0;
+    idt[num].flags = flags;
+    idt[num].offset_high = (handler >> 16) & 0xFFFF;
+}
+
 // 인터럽트 초기화
 void interrupt_init(void) {
     // IDT 초기화
     memset(&idt, 0, sizeof(idt));
     memset(interrupt_handlers, 0, sizeof(interrupt_handlers));
+    memset(exception_handlers, 0, sizeof(exception_handlers));
     memset(irq_handlers, 0, sizeof(irq_handlers));
-    memset(syscall_handlers, 0, sizeof(syscall_handlers));
+    memset(fast_interrupt_handlers, 0, sizeof(fast_interrupt_handlers));
+    
+    // 모든 벡터를 일반 경로 스텁으로 (시스템 콜만 사용자 모드에서 호출 가능)
+    for (uint32_t i = 0; i < 256; i++) {
+        set_idt_gate(i, isr_stub_table[i], i == SYSCALL_VECTOR ? IDT_GATE_USER : IDT_GATE_KERNEL);
+    }
     
     // IDTR 설정
     idtr.limit = sizeof(idt) - 1;
@@ -30,7 +77,14 @@ void interrupt_init(void) {
     // 시스템 콜 초기화
     syscall_init();
     
-    // IDT 로드
+    // 페이지 폴트 핸들러 등록 (요구 페이징)
+    set_exception_handler(EXCEPTION_PAGE_FAULT, page_fault_handler);
+    
+    idt_load();
+}
+
+// IDT 로드 (모든 CPU가 같은 IDT 사용, AP는 부팅 직후 호출)
+void idt_load(void) {
     __asm__ volatile("lidt %0" : : "m" (idtr));
 }
 
@@ -39,6 +93,39 @@ void set_interrupt_handler(uint8_t num, interrupt_handler_t handler) {
     interrupt_handlers[num] = handler;
 }
 
+// 예외 핸들러 설정 (벡터 0~31)
+void set_exception_handler(uint8_t num, exception_handler_t handler) {
+    if (num < 32) {
+        exception_handlers[num] = handler;
+    }
+}
+
+// 처리할 수 없는 예외 (그대로 돌아가면 같은 명령에서 다시 폴트가 나므로 돌아가지 않음)
+// 사용자 모드의 폴트는 현재 프로세스만 종료, 커널 모드의 폴트는 커널 상태를 믿을 수 없으므로 중단
+void exception_fatal(interrupt_context_t* context) {
+    if ((context->cs & 3) == 3 && process_get_current()) {
+        process_exit();
+    }
+    kernel_panic();
+}
+
+// 복구할 수 없는 커널 오류 (출력 장치가 없으므로 이 CPU를 멈추고 디버거로 확인)
+void kernel_panic(void) {
+    disable_interrupts();
+    while (1) {
+        __asm__ volatile("hlt");
+    }
+}
+
+// 빠른 경로 핸들러 설정 (IRQ 벡터만, NULL이면 일반 경로로 되돌림)
+// 자주 오는 인터럽트가 공통 분기와 전체 레지스터 저장을 건너뜀
+void set_fast_interrupt_handler(uint8_t num, fast_interrupt_handler_t handler) {
+    if (num < IRQ0) return;
+    
+    fast_interrupt_handlers[num] = handler;
+    set_idt_gate(num, handler ? isr_fast_table[num - IRQ0] : isr_stub_table[num], IDT_GATE_KERNEL);
+}
+
 // 인터럽트 활성화/비활성화
 void enable_interrupts(void) {
     __asm__ volatile("sti");
@@ -50,85 +137,130 @@ void disable_interrupts(void) {
 
 // IRQ 핸들러 설치/제거
 void irq_install_handler(int irq, interrupt_handler_t handler) {
-    if (irq >= 0 && irq < 16) {
+    if (irq >= 0 && irq < IRQ_LINES) {
         irq_handlers[irq] = handler;
     }
 }
 
 void irq_uninstall_handler(int irq) {
-    if (irq >= 0 && irq < 16) {
+    if (irq >= 0 && irq < IRQ_LINES) {
         irq_handlers[irq] = NULL;
     }
 }
 
+// 인터럽트 컨트롤러 교체 (APIC 초기화에서, 켜 둔 IRQ는 새 컨트롤러에서 다시 켜고 이전 컨트롤러는 모두 마스킹)
+void irq_set_chip(const irq_chip_t* chip) {
+    uint32_t flags = spin_lock_irqsave(&irq_chip_lock);
+    
+    for (uint32_t irq = 0; irq < IRQ_LINES; irq++) {
+        irq_chip->mask(irq);
+    }
+    irq_chip = chip;
+    for (uint32_t irq = 0; irq < IRQ_LINES; irq++) {
+        if (irq_enabled & (1u << irq)) {
+            irq_chip->unmask(irq);
+        }
+    }
+    
+    spin_unlock_irqrestore(&irq_chip_lock, flags);
+}
+
+const irq_chip_t* irq_get_chip(void) {
+    return irq_chip;
+}
+
+// IRQ 마스킹/언마스킹 (컨트롤러 레지스터를 읽지 않고 사본만 갱신해서 쓰기)
+void irq_mask(uint32_t irq) {
+    if (irq >= IRQ_LINES) return;
+    
+    uint32_t flags = spin_lock_irqsave(&irq_chip_lock);
+    irq_enabled &= ~(1u << irq);
+    irq_chip->mask(irq);
+    spin_unlock_irqrestore(&irq_chip_lock, flags);
+}
+
+void irq_unmask(uint32_t irq) {
+    if (irq >= IRQ_LINES) return;
+    
+    uint32_t flags = spin_lock_irqsave(&irq_chip_lock);
+    irq_enabled |= 1u << irq;
+    irq_chip->unmask(irq);
+    spin_unlock_irqrestore(&irq_chip_lock, flags);
+}
+
+// EOI (인터럽트마다 호출되므로 잠금 없음)
+void irq_eoi(uint32_t irq) {
+    irq_chip->eoi(irq);
+}
+
+static void pic_write(uint16_t port, uint8_t value) {
+    __asm__ volatile("outb %0, %1" : : "a" (value), "Nd" (port));
+}
+
+// 마스크 레지스터 갱신 (바뀐 칩 하나만 쓰기)
+static void pic_write_imr(uint32_t irq) {
+    if (irq < 8) {
+        pic_write(PIC_MASTER_DATA, pic_imr & 0xFF);
+    } else {
+        pic_write(PIC_SLAVE_DATA, pic_imr >> 8);
+    }
+}
+
 // PIC 초기화
 void pic_init(void) {
     // ICW1: 초기화 명령
-    __asm__ volatile("outb %0, %1" : : "a" (0x11), "Nd" (0x20));
-    __asm__ volatile("outb %0, %1" : : "a" (0x11), "Nd" (0xA0));
+    pic_write(PIC_MASTER_COMMAND, 0x11);
+    pic_write(PIC_SLAVE_COMMAND, 0x11);
     
     // ICW2: 벡터 오프셋
-    __asm__ volatile("outb %0, %1" : : "a" (0x20), "Nd" (0x21));
-    __asm__ volatile("outb %0, %1" : : "a" (0x28), "Nd" (0xA1));
+    pic_write(PIC_MASTER_DATA, IRQ0);
+    pic_write(PIC_SLAVE_DATA, IRQ8);
     
     // ICW3: 마스터/슬레이브 연결
-    __asm__ volatile("outb %0, %1" : : "a" (0x04), "Nd" (0x21));
-    __asm__ volatile("outb %0, %1" : : "a" (0x02), "Nd" (0xA1));
+    pic_write(PIC_MASTER_DATA, 0x04);
+    pic_write(PIC_SLAVE_DATA, 0x02);
     
     // ICW4: 8086 모드
-    __asm__ volatile("outb %0, %1" : : "a" (0x01), "Nd" (0x21));
-    __asm__ volatile("outb %0, %1" : : "a" (0x01), "Nd" (0xA1));
+    pic_write(PIC_MASTER_DATA, 0x01);
+    pic_write(PIC_SLAVE_DATA, 0x01);
     
-    // 모든 IRQ 마스킹
-    __asm__ volatile("outb %0, %1" : : "a" (0xFF), "Nd" (0x21));
-    __asm__ volatile("outb %0, %1" : : "a" (0xFF), "Nd" (0xA1));
+    // 연쇄 연결(IRQ 2)을 뺀 모든 IRQ 마스킹 (슬레이브 IRQ는 IRQ 2를 거쳐 전달)
+    pic_imr = 0xFFFF & ~(1u << PIC_CASCADE_IRQ);
+    pic_write(PIC_MASTER_DATA, pic_imr & 0xFF);
+    pic_write(PIC_SLAVE_DATA, pic_imr >> 8);
 }
 
 // EOI (End of Interrupt) 전송
-void pic_send_eoi(unsigned char irq) {
+void pic_send_eoi(uint32_t irq) {
     if (irq >= 8) {
-        __asm__ volatile("outb %0, %1" : : "a" (0x20), "Nd" (0xA0));
+        pic_write(PIC_SLAVE_COMMAND, PIC_EOI);
     }
-    __asm__ volatile("outb %0, %1" : : "a" (0x20), "Nd" (0x20));
+    pic_write(PIC_MASTER_COMMAND, PIC_EOI);
 }
 
-// IRQ 마스킹/언마스킹
-void pic_mask_irq(unsigned char irq) {
-    uint16_t port;
-    uint8_t value;
+// IRQ 마스킹/언마스킹 (irq_chip_lock으로 보호)
+void pic_mask_irq(uint32_t irq) {
+    if (irq == PIC_CASCADE_IRQ) return;
     
-    if (irq < 8) {
-        port = 0x21;
-    } else {
-        port = 0xA1;
-        irq -= 8;
-    }
-    
-    value = __asm__ volatile("inb %1, %0" : "=a" (value) : "Nd" (port));
-    value |= (1 << irq);
-    __asm__ volatile("outb %0, %1" : : "a" (value), "Nd" (port));
+    pic_imr |= 1u << irq;
+    pic_write_imr(irq);
 }
 
-void pic_unmask_irq(unsigned char irq) {
-    uint16_t port;
-    uint8_t value;
-    
-    if (irq < 8) {
-        port = 0x21;
-    } else {
-        port = 0xA1;
-        irq -= 8;
-    }
-    
-    value = __asm__ volatile("inb %1, %0" : "=a" (value) : "Nd" (port));
-    value &= ~(1 << irq);
-    __asm__ volatile("outb %0, %1" : : "a" (value), "Nd" (port));
+void pic_unmask_irq(uint32_t irq) {
+    pic_imr &= ~(1u << irq);
+    pic_write_imr(irq);
 }
 
-// 시스템 콜 초기화
+const irq_chip_t pic_chip = {
+    .name = "8259 PIC",
+    .mask = pic_mask_irq,
+    .unmask = pic_unmask_irq,
+    .eoi = pic_send_eoi,
+};
+
+// 시스템 콜 초기화 (공통 핸들러가 컨텍스트를 넘겨 syscall_handler를 호출)
 void syscall_init(void) {
-    // 시스템 콜 인터럽트 핸들러 설정
-    set_interrupt_handler(0x80, (interrupt_handler_t)syscall_handler);
+    memset(syscall_handlers, 0, sizeof(syscall_handlers));
 }
 
 // 시스템 콜 등록
@@ -138,100 +270,111 @@ void register_syscall(int num, syscall_handler_t handler) {
     }
 }
 
-// 시스템 콜 핸들러
-int syscall_handler(interrupt_context_t* context) {
-    int syscall_num = context->eax;
-    int arg1 = context->ebx;
-    int arg2 = context->ecx;
-    int arg3 = context->edx;
-    
-    if (syscall_num >= 0 && syscall_num < SYSCALL_MAX && syscall_handlers[syscall_num]) {
+// 시스템 콜 분기 (int 0x80과 SYSENTER 경로가 같은 표를 씀)
+static int syscall_dispatch(uint32_t syscall_num, int arg1, int arg2, int arg3) {
+    if (syscall_num < SYSCALL_MAX && syscall_handlers[syscall_num]) {
         return syscall_handlers[syscall_num](arg1, arg2, arg3);
     }
     
     return -1; // 잘못된 시스템 콜
 }
 
+// 진행 중인 시스템 콜의 트랩 프레임 기록 (fork가 자식 커널 스택에 복사해 같은 지점으로 돌려보냄)
+// 사용자 모드에서 들어온 프레임만 커널 스택 맨 위에 있으므로 커널 모드에서 부른 시스템 콜은 NULL
+static void syscall_record_frame(void* frame, uint32_t eax_offset, void (*return_path)(void)) {
+    process_t* process = process_get_current();
+    if (!process) return;
+    
+    process->trap_frame = (uint32_t)frame;
+    process->trap_eax_offset = eax_offset;
+    process->trap_return = return_path;
+}
+
+// 시스템 콜 핸들러 (int 0x80, 번호는 eax, 인자는 ebx/ecx/edx)
+// 처리 중에는 호출한 쪽의 인터럽트 상태로 되돌려 틱, IPI, 장치 IRQ를 막지 않음
+int syscall_handler(interrupt_context_t* context) {
+    if ((context->cs & 3) == 3) {
+        syscall_record_frame(context, offsetof(interrupt_context_t, eax), interrupt_return);
+    } else {
+        syscall_record_frame(NULL, 0, NULL);
+    }
+    
+    irq_restore(context->eflags);
+    int result = syscall_dispatch(context->eax, context->ebx, context->ecx, context->edx);
+    disable_interrupts();
+    
+    return result;
+}
+
+// SYSENTER 핸들러 (isr.asm의 sysenter_entry가 인터럽트를 끈 채 호출)
+// SYSEXIT가 ecx/edx를 복귀 스택/주소로 쓰므로 사용자 스텁(user/syscall.asm)이
+// ebp가 가리키는 사용자 스택에 복귀 주소, 인자 2, 3을 넣어 둠
+void sysenter_handler(sysenter_frame_t* frame) {
+    account_kernel_enter(1);
+    
+    // 스텁 프레임이 사용자 영역 밖이면 돌아갈 곳을 믿을 수 없으므로 종료
+    if (frame->ebp < USER_SPACE_START || frame->ebp > USER_STACK_TOP - 3 * sizeof(uint32_t)) {
+        process_exit();
+    }
+    
+    uint32_t* user_frame = (uint32_t*)frame->ebp;
+    frame->user_eip = user_frame[0];
+    frame->user_esp = frame->ebp + sizeof(uint32_t);
+    syscall_record_frame(frame, offsetof(sysenter_frame_t, eax), sysenter_return);
+    
+    // 처리 중에는 인터럽트를 켜고, SYSEXIT 경로는 다시 끈 채로 (sysenter_return의 sti까지)
+    enable_interrupts();
+    frame->eax = (uint32_t)syscall_dispatch(frame->eax, frame->ebx, user_frame[1], user_frame[2]);
+    disable_interrupts();
+    
+    scheduler_irq_exit();
+    account_kernel_exit();
+}
+
 // 공통 인터럽트 핸들러
 void common_interrupt_handler(interrupt_context_t* context) {
     uint32_t int_no = context->int_no;
     
+    // 여기까지의 시간은 중단된 모드(사용자/커널)의 시간
+    account_kernel_enter((context->cs & 3) == 3);
+    uint32_t start = irq_stat_start();
+    
     // IRQ 처리
-    if (int_no >= IRQ0 && int_no < IRQ0 + 16) {
+    if (int_no >= IRQ0 && int_no < IRQ0 + IRQ_LINES) {
         int irq = int_no - IRQ0;
         if (irq_handlers[irq]) {
             irq_handlers[irq]();
         }
-        pic_send_eoi(irq);
+        irq_stat_end(int_no, start);
+        irq_eoi(irq);
+        
+        // EOI 이후에 softirq와 선점 (전환된 프로세스가 다음 인터럽트를 받을 수 있도록)
+        irq_exit();
     }
-    // 예외 처리
+    // 예외 처리 (핸들러가 없는 예외는 폴트가 난 프로세스 종료 또는 커널 중단)
     else if (int_no < 32) {
-        // 예외 처리 (실제 구현에서는 더 복잡)
-        (void)int_no;
+        if (exception_handlers[int_no]) {
+            exception_handlers[int_no](context);
+            irq_stat_end(int_no, start);
+        } else {
+            irq_stat_end(int_no, start);
+            exception_fatal(context);
+        }
     }
-    // 일반 인터럽트 처리
-    else if (interrupt_handlers[int_no]) {
-        interrupt_handlers[int_no]();
+    // 시스템 콜 (반환값은 복귀할 때 eax로, 도중에 깨운 프로세스가 선점하면 복귀 전에 전환)
+    // 잠들 수 있고 인터럽트를 켠 채 처리하므로 처리 시간은 재지 않고 횟수만
+    else if (int_no == SYSCALL_VECTOR) {
+        irq_stat_count(int_no);
+        context->eax = (uint32_t)syscall_handler(context);
+        scheduler_irq_exit();
     }
+    // 일반 인터럽트 처리 (핸들러가 없는 벡터도 횟수는 셈)
+    else {
+        if (interrupt_handlers[int_no]) {
+            interrupt_handlers[int_no]();
+        }
+        irq_stat_end(int_no, start);
+    }
+    
+    account_kernel_exit();
 }
-
-// 인터럽트 게이트 설정 (어셈블리에서 호출)
-void set_idt_gate(uint8_t num, uint32_t handler) {
-    idt[num].offset_low = handler & 0xFFFF;
-    idt[num].selector = 0x08; // 커널 코드 세그먼트
-    idt[num].zero = 0;
-    idt[num].flags = 0x8E; // 인터럽트 게이트
-    idt[num].offset_high = (handler >> 16) & 0xFFFF;
-}
-
-// 기본 인터럽트 핸들러들 (어셈블리에서 호출)
-void isr0() { common_interrupt_handler(NULL); }
-void isr1() { common_interrupt_handler(NULL); }
-void isr2() { common_interrupt_handler(NULL); }
-void isr3() { common_interrupt_handler(NULL); }
-void isr4() { common_interrupt_handler(NULL); }
-void isr5() { common_interrupt_handler(NULL); }
-void isr6() { common_interrupt_handler(NULL); }
-void isr7() { common_interrupt_handler(NULL); }
-void isr8() { common_interrupt_handler(NULL); }
-void isr9() { common_interrupt_handler(NULL); }
-void isr10() { common_interrupt_handler(NULL); }
-void isr11() { common_interrupt_handler(NULL); }
-void isr12() { common_interrupt_handler(NULL); }
-void isr13() { common_interrupt_handler(NULL); }
-void isr14() { common_interrupt_handler(NULL); }
-void isr15() { common_interrupt_handler(NULL); }
-void isr16() { common_interrupt_handler(NULL); }
-void isr17() { common_interrupt_handler(NULL); }
-void isr18() { common_interrupt_handler(NULL); }
-void isr19() { common_interrupt_handler(NULL); }
-void isr20() { common_interrupt_handler(NULL); }
-void isr21() { common_interrupt_handler(NULL); }
-void isr22() { common_interrupt_handler(NULL); }
-void isr23() { common_interrupt_handler(NULL); }
-void isr24() { common_interrupt_handler(NULL); }
-void isr25() { common_interrupt_handler(NULL); }
-void isr26() { common_interrupt_handler(NULL); }
-void isr27() { common_interrupt_handler(NULL); }
-void isr28() { common_interrupt_handler(NULL); }
-void isr29() { common_interrupt_handler(NULL); }
-void isr30() { common_interrupt_handler(NULL); }
-void isr31() { common_interrupt_handler(NULL); }
-
-// IRQ 핸들러들
-void irq0() { common_interrupt_handler(NULL); }
-void irq1() { common_interrupt_handler(NULL); }
-void irq2() { common_interrupt_handler(NULL); }
-void irq3() { common_interrupt_handler(NULL); }
-void irq4() { common_interrupt_handler(NULL); }
-void irq5() { common_interrupt_handler(NULL); }
-void irq6() { common_interrupt_handler(NULL); }
-void irq7() { common_interrupt_handler(NULL); }
-void irq8() { common_interrupt_handler(NULL); }
-void irq9() { common_interrupt_handler(NULL); }
-void irq10() { common_interrupt_handler(NULL); }
-void irq11() { common_interrupt_handler(NULL); }
-void irq12() { common_interrupt_handler(NULL); }
-void irq13() { common_interrupt_handler(NULL); }
-void irq14() { common_interrupt_handler(NULL); }
-void irq15() { common_interrupt_handler(NULL); }
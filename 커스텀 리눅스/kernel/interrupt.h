@@ -21,36 +21,102 @@ typedef struct {
 // 인터럽트 핸들러 타입
 typedef void (*interrupt_handler_t)(void);
 
-// 인터럽트 컨텍스트 구조체
-typedef struct {
+// 인터럽트 컨텍스트 구조체 (isr.asm의 일반 경로가 스택에 만드는 순서)
+typedef struct interrupt_context {
+    uint32_t es, ds;
     uint32_t edi, esi, ebp, esp;
     uint32_t ebx, edx, ecx, eax;
     uint32_t int_no, err_code;
     uint32_t eip, cs, eflags;
-    uint32_t user_esp, user_ss;
+    uint32_t user_esp, user_ss;     // 사용자 모드에서 진입했을 때만 유효
 } interrupt_context_t;
 
+// 빠른 경로 프레임 (호출자 저장 레지스터와 CPU가 넣은 값만, isr.asm의 빠른 경로가 만드는 순서)
+typedef struct {
+    uint32_t es, ds;
+    uint32_t edx, ecx, eax;
+    uint32_t eip, cs, eflags;
+} interrupt_frame_t;
+
+// SYSENTER 프레임 (isr.asm의 sysenter_entry가 만드는 순서, user_eip/user_esp는 SYSEXIT가 쓸 값)
+typedef struct {
+    uint32_t es, ds;
+    uint32_t eax;                   // 시스템 콜 번호 (돌아갈 때는 반환값)
+    uint32_t ebx;                   // 인자 1
+    uint32_t ebp;                   // 사용자 스텁의 스택 프레임 (복귀 주소, 인자 2, 3)
+    uint32_t user_eip, user_esp;
+} sysenter_frame_t;
+
+// 예외 핸들러 (벡터 0~31, 오류 코드와 폴트가 난 모드를 보도록 컨텍스트를 받음)
+typedef void (*exception_handler_t)(interrupt_context_t* context);
+
+// 빠른 경로 핸들러 (EOI와 CPU 시간 회계, irq_exit까지 핸들러가 직접 처리)
+typedef void (*fast_interrupt_handler_t)(interrupt_frame_t* frame);
+
 // 인터럽트 관련 함수들
 void interrupt_init(void);
+void idt_load(void);
 void set_interrupt_handler(uint8_t num, interrupt_handler_t handler);
+void set_exception_handler(uint8_t num, exception_handler_t handler);
+void exception_fatal(interrupt_context_t* context);
+void kernel_panic(void);
+void set_fast_interrupt_handler(uint8_t num, fast_interrupt_handler_t handler);
 void enable_interrupts(void);
 void disable_interrupts(void);
 void irq_install_handler(int irq, interrupt_handler_t handler);
 void irq_uninstall_handler(int irq);
 
+// 인터럽트 상태 저장 후 비활성화 / 저장한 상태로 복원
+static inline uint32_t irq_save(void) {
+    uint32_t flags;
+    __asm__ volatile("pushf; pop %0; cli" : "=r" (flags) : : "memory");
+    return flags;
+}
+
+static inline void irq_restore(uint32_t flags) {
+    if (flags & 0x200) {
+        __asm__ volatile("sti" : : : "memory");
+    }
+}
+
+// 인터럽트 컨트롤러 (ISA IRQ 번호로 마스킹/EOI, 어느 쪽이든 IRQ n은 벡터 IRQ0 + n)
+typedef struct irq_chip {
+    const char* name;
+    void (*mask)(uint32_t irq);
+    void (*unmask)(uint32_t irq);
+    void (*eoi)(uint32_t irq);
+} irq_chip_t;
+
+#define IRQ_LINES 16
+
+extern const irq_chip_t pic_chip;   // 8259 PIC (APIC가 없을 때)
+
+// 인터럽트 컨트롤러 함수들 (irq_set_chip 전까지는 8259 PIC)
+void irq_set_chip(const irq_chip_t* chip);
+const irq_chip_t* irq_get_chip(void);
+void irq_mask(uint32_t irq);
+void irq_unmask(uint32_t irq);
+void irq_eoi(uint32_t irq);
+
 // PIC 관련 함수들
 void pic_init(void);
-void pic_send_eoi(unsigned char irq);
-void pic_mask_irq(unsigned char irq);
-void pic_unmask_irq(unsigned char irq);
+void pic_send_eoi(uint32_t irq);
+void pic_mask_irq(uint32_t irq);
+void pic_unmask_irq(uint32_t irq);
 
 // 시스템 콜 관련
+#define SYSCALL_VECTOR 0x80         // 사용자 모드에서 호출할 수 있는 게이트 (DPL 3)
 #define SYSCALL_MAX 256
 typedef int (*syscall_handler_t)(int, int, int);
 
 void syscall_init(void);
 void register_syscall(int num, syscall_handler_t handler);
 int syscall_handler(interrupt_context_t* context);
+void sysenter_handler(sysenter_frame_t* frame);
+
+// 트랩 프레임으로 사용자 모드에 돌아가는 경로 (isr.asm, esp가 프레임을 가리킨 상태로 진입)
+void interrupt_return(void);
+void sysenter_return(void);
 
 // 인터럽트 번호 정의
 #define IRQ0 32
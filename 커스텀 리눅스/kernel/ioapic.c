@@ -0,0 +1,138 @@
+#include "ioapic.h"
+#include "apic.h"
+#include "memory.h"
+#include "spinlock.h"
+#include <string.h>
+
+// 매핑된 I/O APIC
+typedef struct {
+    volatile uint32_t* regs;
+    uint32_t gsi_base;
+    uint32_t pins;                  // 재지정 엔트리 수
+} ioapic_t;
+
+// ISA IRQ별 재지정 엔트리 (하위 32비트 사본을 두어 마스킹이 쓰기 한 번)
+typedef struct {
+    ioapic_t* ioapic;               // 연결되지 않은 IRQ는 NULL
+    uint32_t pin;
+    uint32_t low;
+} ioapic_route_t;
+
+static ioapic_t ioapics[ACPI_MAX_IOAPICS];
+static uint32_t ioapic_count = 0;
+static ioapic_route_t routes[IRQ_LINES];
+
+// 선택/창 레지스터 쌍은 원자적이지 않으므로 모든 CPU가 이 잠금으로 순서를 맞춤
+// (마스킹은 irq_chip_lock 안에서 오지만 친화성 변경은 따로 옴)
+static spinlock_t ioapic_lock = SPINLOCK_INIT;
+
+static uint32_t ioapic_read(ioapic_t* ioapic, uint32_t reg) {
+    ioapic->regs[IOAPIC_REGSEL >> 2] = reg;
+    return ioapic->regs[IOAPIC_WINDOW >> 2];
+}
+
+static void ioapic_write(ioapic_t* ioapic, uint32_t reg, uint32_t value) {
+    ioapic->regs[IOAPIC_REGSEL >> 2] = reg;
+    ioapic->regs[IOAPIC_WINDOW >> 2] = value;
+}
+
+static void route_write_low(ioapic_route_t* route) {
+    uint32_t flags = spin_lock_irqsave(&ioapic_lock);
+    ioapic_write(route->ioapic, IOAPIC_REG_REDIRECTION + route->pin * 2, route->low);
+    spin_unlock_irqrestore(&ioapic_lock, flags);
+}
+
+// GSI를 받는 I/O APIC
+static ioapic_t* ioapic_for_gsi(uint32_t gsi) {
+    for (uint32_t i = 0; i < ioapic_count; i++) {
+        if (gsi >= ioapics[i].gsi_base && gsi - ioapics[i].gsi_base < ioapics[i].pins) {
+            return &ioapics[i];
+        }
+    }
+    return NULL;
+}
+
+// I/O APIC 초기화 (모든 엔트리를 마스킹한 뒤 ISA IRQ n을 벡터 IRQ0 + n, BSP로 재지정)
+int ioapic_init(const acpi_madt_info_t* madt) {
+    memset(routes, 0, sizeof(routes));
+    ioapic_count = 0;
+    
+    for (uint32_t i = 0; i < madt->ioapic_count; i++) {
+        ioapic_t* ioapic = &ioapics[ioapic_count];
+        ioapic->regs = (volatile uint32_t*)ioremap(madt->ioapics[i].address, PAGE_SIZE);
+        if (!ioapic->regs) continue;
+        
+        ioapic->gsi_base = madt->ioapics[i].gsi_base;
+        ioapic->pins = ((ioapic_read(ioapic, IOAPIC_REG_VERSION) >> 16) & 0xFF) + 1;
+        for (uint32_t pin = 0; pin < ioapic->pins; pin++) {
+            ioapic_write(ioapic, IOAPIC_REG_REDIRECTION + pin * 2, IOAPIC_MASKED);
+        }
+        ioapic_count++;
+    }
+    if (!ioapic_count) return -1;
+    
+    uint32_t bsp_apic_id = lapic_id();
+    for (uint32_t irq = 0; irq < IRQ_LINES; irq++) {
+        // IRQ 2는 8259의 연쇄 연결 (장치가 없고 GSI 2는 보통 IRQ 0의 재지정 대상)
+        if (irq == 2) continue;
+        
+        uint32_t gsi = madt->isa_gsi[irq];
+        ioapic_t* ioapic = ioapic_for_gsi(gsi);
+        if (!ioapic) continue;
+        
+        uint32_t low = IOAPIC_MASKED | (IRQ0 + irq);
+        if ((madt->isa_flags[irq] & MPS_POLARITY_MASK) == MPS_POLARITY_LOW) {
+            low |= IOAPIC_ACTIVE_LOW;
+        }
+        if ((madt->isa_flags[irq] & MPS_TRIGGER_MASK) == MPS_TRIGGER_LEVEL) {
+            low |= IOAPIC_LEVEL;
+        }
+        
+        ioapic_route_t* route = &routes[irq];
+        route->ioapic = ioapic;
+        route->pin = gsi - ioapic->gsi_base;
+        route->low = low;
+        ioapic_write(ioapic, IOAPIC_REG_REDIRECTION + route->pin * 2 + 1, bsp_apic_id << 24);
+        ioapic_write(ioapic, IOAPIC_REG_REDIRECTION + route->pin * 2, low);
+    }
+    
+    return 0;
+}
+
+// IRQ를 받을 CPU 변경 (Local APIC ID, 여러 CPU로 인터럽트를 나눌 때)
+void ioapic_set_affinity(uint32_t irq, uint32_t apic_id) {
+    if (irq >= IRQ_LINES || !routes[irq].ioapic) return;
+    
+    ioapic_route_t* route = &routes[irq];
+    uint32_t flags = spin_lock_irqsave(&ioapic_lock);
+    ioapic_write(route->ioapic, IOAPIC_REG_REDIRECTION + route->pin * 2 + 1, apic_id << 24);
+    spin_unlock_irqrestore(&ioapic_lock, flags);
+}
+
+// irq_chip 연산 (마스킹은 irq_chip_lock 안에서 호출)
+static void ioapic_mask_irq(uint32_t irq) {
+    if (!routes[irq].ioapic) return;
+    
+    routes[irq].low |= IOAPIC_MASKED;
+    route_write_low(&routes[irq]);
+}
+
+static void ioapic_unmask_irq(uint32_t irq) {
+    if (!routes[irq].ioapic) return;
+    
+    routes[irq].low &= ~IOAPIC_MASKED;
+    route_write_low(&routes[irq]);
+}
+
+// EOI는 Local APIC에 (I/O 포트 대신 메모리 쓰기 한 번)
+static void ioapic_eoi(uint32_t irq) {
+    (void)irq;
+    lapic_eoi();
+}
+
+const irq_chip_t ioapic_chip = {
+    .name = "IO-APIC",
+    .mask = ioapic_mask_irq,
+    .unmask = ioapic_unmask_irq,
+    .eoi = ioapic_eoi,
+};
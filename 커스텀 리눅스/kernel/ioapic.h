@@ -0,0 +1,32 @@
+#ifndef IOAPIC_H
+#define IOAPIC_H
+
+#include <stdint.h>
+#include "acpi.h"
+#include "interrupt.h"
+
+// I/O APIC 레지스터 (선택 레지스터에 번호를 쓰고 창 레지스터로 읽기/쓰기)
+#define IOAPIC_REGSEL 0x00
+#define IOAPIC_WINDOW 0x10
+
+#define IOAPIC_REG_VERSION 0x01             // 비트 16~23: 마지막 재지정 엔트리 번호
+#define IOAPIC_REG_REDIRECTION 0x10         // 엔트리 n의 하위 32비트 = 0x10 + 2n, 상위 = 0x11 + 2n
+
+// 재지정 엔트리 하위 32비트 (고정 전달, 물리 목적지)
+#define IOAPIC_ACTIVE_LOW 0x2000
+#define IOAPIC_LEVEL 0x8000
+#define IOAPIC_MASKED 0x10000
+
+// MADT 재지정 엔트리의 극성/트리거 플래그 (00은 버스 기본값, ISA는 상승 에지)
+#define MPS_POLARITY_MASK 0x3
+#define MPS_POLARITY_LOW 0x3
+#define MPS_TRIGGER_MASK 0xC
+#define MPS_TRIGGER_LEVEL 0xC
+
+extern const irq_chip_t ioapic_chip;
+
+// I/O APIC 함수들
+int ioapic_init(const acpi_madt_info_t* madt);
+void ioapic_set_affinity(uint32_t irq, uint32_t apic_id);
+
+#endif // IOAPIC_H
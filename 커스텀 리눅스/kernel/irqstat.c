@@ -0,0 +1,123 @@
+#include "irqstat.h"
+#include "interrupt.h"
+#include "apic.h"
+#include "procfs.h"
+#include <string.h>
+
+irq_cpu_stat_t irq_cpu_stats[SMP_MAX_CPUS];
+
+// 분포 칸의 경계 (클럭, 칸 k의 상한은 2^(IRQ_STAT_MIN_SHIFT + k))
+static const char* bucket_labels[IRQ_STAT_BUCKETS] = {
+    "<512", "<1K", "<2K", "<4K", "<8K", "<16K", "<32K", "<64K",
+    "<128K", "<256K", "<512K", "<1M", "<2M", "<4M", "<8M", ">=8M"
+};
+
+// 벡터 설명 (/proc 출력용)
+static void put_vector_name(proc_buffer_t* buffer, uint32_t vector) {
+    if (vector < IRQ0) {
+        proc_puts(buffer, "exception ");
+        proc_put_uint(buffer, vector, 0);
+    } else if (vector < IRQ0 + IRQ_LINES) {
+        proc_puts(buffer, irq_get_chip()->name);
+        proc_puts(buffer, " IRQ ");
+        proc_put_uint(buffer, vector - IRQ0, 0);
+    } else if (vector == SYSCALL_VECTOR) {
+        proc_puts(buffer, "system call (int 0x80)");
+    } else if (vector == LAPIC_TIMER_VECTOR) {
+        proc_puts(buffer, "Local APIC timer");
+    } else if (vector == RESCHEDULE_VECTOR) {
+        proc_puts(buffer, "reschedule IPI");
+    } else if (vector == LAPIC_SPURIOUS_VECTOR) {
+        proc_puts(buffer, "spurious");
+    } else {
+        proc_puts(buffer, "vector");
+    }
+}
+
+static void put_vector(proc_buffer_t* buffer, uint32_t vector) {
+    proc_put_uint(buffer, vector, 4);
+    proc_puts(buffer, ":");
+}
+
+// /proc/interrupts: 한 번이라도 온 벡터의 CPU별 횟수
+static void show_interrupts(proc_buffer_t* buffer) {
+    uint32_t cpus = smp_cpu_count();
+    
+    proc_puts(buffer, "     ");
+    for (uint32_t cpu = 0; cpu < cpus; cpu++) {
+        proc_puts(buffer, cpu < 10 ? "          CPU" : "         CPU");
+        proc_put_uint(buffer, cpu, 0);
+    }
+    proc_puts(buffer, "\n");
+    
+    for (uint32_t vector = 0; vector < IRQ_STAT_VECTORS; vector++) {
+        uint32_t total = 0;
+        for (uint32_t cpu = 0; cpu < cpus; cpu++) {
+            total += irq_cpu_stats[cpu].count[vector];
+        }
+        if (!total) continue;
+        
+        put_vector(buffer, vector);
+        for (uint32_t cpu = 0; cpu < cpus; cpu++) {
+            proc_put_uint(buffer, irq_cpu_stats[cpu].count[vector], 14);
+        }
+        proc_puts(buffer, "  ");
+        put_vector_name(buffer, vector);
+        proc_puts(buffer, "\n");
+    }
+}
+
+// /proc/interrupt_latency: 벡터별 처리 시간 분포 (모든 CPU 합, 칸은 TSC 클럭)
+static void show_latency(proc_buffer_t* buffer) {
+    proc_puts(buffer, "TSC kHz: ");
+    proc_put_uint(buffer, tsc_khz, 0);
+    proc_puts(buffer, "\ncycles");
+    for (uint32_t bucket = 0; bucket < IRQ_STAT_BUCKETS; bucket++) {
+        uint32_t length = strlen(bucket_labels[bucket]);
+        for (uint32_t pad = length; pad < 8; pad++) {
+            proc_puts(buffer, " ");
+        }
+        proc_puts(buffer, bucket_labels[bucket]);
+    }
+    proc_puts(buffer, "\n");
+    
+    for (uint32_t vector = 0; vector < IRQ_STAT_VECTORS; vector++) {
+        irq_stat_t stat;
+        irq_stat_get(vector, &stat);
+        
+        uint32_t timed = 0;
+        for (uint32_t bucket = 0; bucket < IRQ_STAT_BUCKETS; bucket++) {
+            timed += stat.hist[bucket];
+        }
+        if (!timed) continue;
+        
+        put_vector(buffer, vector);
+        proc_puts(buffer, " ");
+        for (uint32_t bucket = 0; bucket < IRQ_STAT_BUCKETS; bucket++) {
+            proc_put_uint(buffer, stat.hist[bucket], 8);
+        }
+        proc_puts(buffer, "  ");
+        put_vector_name(buffer, vector);
+        proc_puts(buffer, "\n");
+    }
+}
+
+// /proc 파일 등록 (카운터는 부팅 때부터 세므로 지우지 않음)
+void irq_stat_init(void) {
+    proc_create("interrupts", show_interrupts);
+    proc_create("interrupt_latency", show_latency);
+}
+
+// 한 벡터의 통계 (모든 CPU 합, 기록 중인 CPU와 겹치면 한 건 차이가 날 수 있음)
+int irq_stat_get(uint32_t vector, irq_stat_t* stat) {
+    if (vector >= IRQ_STAT_VECTORS || !stat) return -1;
+    
+    memset(stat, 0, sizeof(irq_stat_t));
+    for (uint32_t cpu = 0; cpu < smp_cpu_count(); cpu++) {
+        stat->count += irq_cpu_stats[cpu].count[vector];
+        for (uint32_t bucket = 0; bucket < IRQ_STAT_BUCKETS; bucket++) {
+            stat->hist[bucket] += irq_cpu_stats[cpu].hist[vector][bucket];
+        }
+    }
+    return 0;
+}
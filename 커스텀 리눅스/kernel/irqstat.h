@@ -0,0 +1,55 @@
+#ifndef IRQSTAT_H
+#define IRQSTAT_H
+
+#include <stdint.h>
+#include "smp.h"
+#include "tsc.h"
+
+// 벡터별 인터럽트 횟수와 처리 시간 분포 (CPU별로 세므로 기록에 잠금/원자 연산 없음)
+// 처리 시간은 핸들러 구간만 (irq_exit의 softirq와 전환은 제외), TSC 클럭 수의 log2 칸
+
+#define IRQ_STAT_VECTORS 256
+#define IRQ_STAT_BUCKETS 16
+#define IRQ_STAT_MIN_SHIFT 9        // 첫 칸은 2^9 클럭 미만, 칸 k는 2^(8+k) 이상 2^(9+k) 미만, 마지막 칸은 그 이상 전부
+
+typedef struct {
+    uint32_t count[IRQ_STAT_VECTORS];
+    uint32_t hist[IRQ_STAT_VECTORS][IRQ_STAT_BUCKETS];
+} irq_cpu_stat_t;
+
+// 시스템 콜로 돌려주는 한 벡터의 통계 (모든 CPU 합)
+typedef struct {
+    uint32_t count;
+    uint32_t hist[IRQ_STAT_BUCKETS];
+} irq_stat_t;
+
+extern irq_cpu_stat_t irq_cpu_stats[SMP_MAX_CPUS];
+
+// 핸들러 시작 시각 (TSC 하위 32비트, 한 번의 처리는 2^32 클럭보다 짧음)
+static inline uint32_t irq_stat_start(void) {
+    return tsc_khz ? (uint32_t)tsc_read() : 0;
+}
+
+// 횟수만 (잠들 수 있는 시스템 콜처럼 시간이 의미 없는 경우)
+static inline void irq_stat_count(uint32_t vector) {
+    irq_cpu_stats[smp_cpu_id()].count[vector]++;
+}
+
+// 핸들러 끝 (인터럽트를 끈 상태에서 호출)
+static inline void irq_stat_end(uint32_t vector, uint32_t start) {
+    irq_cpu_stat_t* stat = &irq_cpu_stats[smp_cpu_id()];
+    stat->count[vector]++;
+    if (!tsc_khz) return;
+    
+    uint32_t cycles = (uint32_t)tsc_read() - start;
+    uint32_t bucket = 31 - __builtin_clz(cycles | 1);
+    bucket = bucket >= IRQ_STAT_MIN_SHIFT ? bucket - IRQ_STAT_MIN_SHIFT + 1 : 0;
+    if (bucket >= IRQ_STAT_BUCKETS) bucket = IRQ_STAT_BUCKETS - 1;
+    stat->hist[vector][bucket]++;
+}
+
+// 인터럽트 통계 함수들
+void irq_stat_init(void);
+int irq_stat_get(uint32_t vector, irq_stat_t* stat);
+
+#endif // IRQSTAT_H
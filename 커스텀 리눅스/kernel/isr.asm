@@ -0,0 +1,136 @@
+; 인터럽트 진입 스텁
+; 모든 벡터가 interrupt_context_t를 스택에 만들어 common_interrupt_handler를 호출 (isr_stub_table)
+; IRQ 벡터(32~255)는 호출자 저장 레지스터만 저장하고 등록된 핸들러를 바로 부르는 빠른 경로도 있음
+; (isr_fast_table, set_fast_interrupt_handler가 IDT 게이트를 이쪽으로 바꿈)
+; 시스템 콜은 int 0x80 게이트 외에 SYSENTER 진입점도 있음 (sysenter_entry)
+
+%define KERNEL_DATA 0x10
+%define FAST_FIRST_VECTOR 32
+
+[bits 32]
+section .text
+
+global isr_stub_table
+global isr_fast_table
+global sysenter_entry
+global interrupt_return
+global sysenter_return
+extern common_interrupt_handler
+extern fast_interrupt_handlers
+extern sysenter_handler
+
+; 일반 경로 스텁 (CPU가 오류 코드를 넣지 않는 벡터는 자리를 채워 프레임 모양을 맞춤)
+%assign i 0
+%rep 256
+isr_stub_%+i:
+%if !(i == 8 || (i >= 10 && i <= 14) || i == 17 || i == 21 || i == 29 || i == 30)
+    push dword 0            ; 오류 코드 자리
+%endif
+    push dword i            ; 벡터 번호
+    jmp interrupt_common
+%assign i i + 1
+%endrep
+
+; 빠른 경로 스텁 (벡터 번호는 eax로 넘김)
+%assign i FAST_FIRST_VECTOR
+%rep 256 - FAST_FIRST_VECTOR
+isr_fast_%+i:
+    push eax
+    mov eax, i
+    jmp fast_common
+%assign i i + 1
+%endrep
+
+; 일반 경로: 범용/세그먼트 레지스터를 모두 저장 (interrupt_context_t 순서)
+interrupt_common:
+    pusha
+    push ds
+    push es
+    mov ax, KERNEL_DATA     ; 사용자 모드가 바꿔 둔 데이터 세그먼트 대신 커널 것으로
+    mov ds, ax
+    mov es, ax
+    cld
+
+    push esp                ; interrupt_context_t*
+    call common_interrupt_handler
+    add esp, 4
+
+; 일반 경로 복귀 (fork한 자식은 복사한 프레임을 스택에 두고 여기로 바로 옴)
+interrupt_return:
+    pop es
+    pop ds
+    popa
+    add esp, 8              ; 벡터 번호와 오류 코드
+    iret
+
+; 빠른 경로: 호출자 저장 레지스터만 저장 (나머지는 C 호출 규약으로 핸들러가 보존)
+; 핸들러 안에서 전환되어도 switch_stacks가 나머지 레지스터를 저장하므로 안전
+fast_common:
+    push ecx
+    push edx
+    push ds
+    push es
+    mov dx, KERNEL_DATA
+    mov ds, dx
+    mov es, dx
+    cld
+
+    push esp                ; interrupt_frame_t*
+    call [fast_interrupt_handlers + eax * 4]
+    add esp, 4
+
+    pop es
+    pop ds
+    pop edx
+    pop ecx
+    pop eax
+    iret
+
+; SYSENTER 진입 (CPU가 CS/SS를 커널 것으로, EIP/ESP를 MSR 값으로 바꾸고 인터럽트를 끈 상태)
+; MSR의 ESP는 이 CPU의 esp0 복사본을 가리키므로 먼저 현재 프로세스의 커널 스택으로 바꿈
+; 일반 경로와 달리 CPU가 아무것도 넣지 않으므로 필요한 레지스터만 sysenter_frame_t로 저장
+sysenter_entry:
+    mov esp, [esp]
+    sub esp, 8              ; user_eip, user_esp (핸들러가 채움)
+    push ebp
+    push ebx
+    push eax
+    push ds
+    push es
+    mov ax, KERNEL_DATA
+    mov ds, ax
+    mov es, ax
+    cld
+
+    push esp                ; sysenter_frame_t*
+    call sysenter_handler
+    add esp, 4
+
+; SYSEXIT 복귀 (fork한 자식도 여기로)
+sysenter_return:
+    pop es
+    pop ds
+    pop eax                 ; 반환값
+    pop ebx
+    pop ebp
+    pop edx                 ; SYSEXIT는 edx로 복귀하고
+    pop ecx                 ; ecx를 사용자 스택으로
+    sti                     ; sti 다음 한 명령까지는 인터럽트가 지연되므로 sysexit 전에 끼어들지 않음
+    sysexit
+
+section .rodata
+
+; 벡터별 스텁 주소 (interrupt_init이 IDT를 채움)
+isr_stub_table:
+%assign i 0
+%rep 256
+    dd isr_stub_%+i
+%assign i i + 1
+%endrep
+
+isr_fast_table:
+%assign i FAST_FIRST_VECTOR
+%rep 256 - FAST_FIRST_VECTOR
+    dd isr_fast_%+i
+%assign i i + 1
+%endrep
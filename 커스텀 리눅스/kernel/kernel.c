@@ -2,47 +2,56 @@
 #include "interrupt.h"
 #include "scheduler.h"
 #include "filesystem.h"
+#include "gdt.h"
+#include "fpu.h"
+#include "smp.h"
+#include "apic.h"
+#include "irqstat.h"
+#include "tsc.h"
+#include "futex.h"
+#include "workqueue.h"
 #include <stdint.h>
 
+void init_process(void);
+
 // 커널 진입점
 void kernel_main(void) {
     // 1. 메모리 관리 초기화
-    memory_init(0x100000, 64 * 1024 * 1024); // 64MB 힙
+    memory_init((const e820_map_t*)E820_MAP_ADDR); // Stage 2가 수집한 E820 맵
     paging_init();
     
-    // 2. 인터럽트 시스템 초기화
+    // 2. 세그먼트(GDT/TSS)와 인터럽트 시스템 초기화
+    gdt_init();
     interrupt_init();
+    fpu_init();
+    tsc_init(); // PIT로 TSC 주파수 보정 (CPU 시간 회계)
+    apic_init(); // ACPI MADT에 APIC가 있으면 8259 PIC 대신 I/O APIC, 틱은 Local APIC 타이머
     
     // 3. 파일 시스템 초기화
     fs_init();
+    irq_stat_init(); // /proc/interrupts, /proc/interrupt_latency
     
     // 4. 스케줄러 초기화
     scheduler_init();
     
-    // 5. 인터럽트 활성화
+    // 5. 다른 CPU 시작 (ACPI MADT의 AP를 INIT-SIPI-SIPI로 깨움, 각자 자기 준비 큐를 가짐)
+    smp_init();
+    
+    // 6. 인터럽트 활성화
     enable_interrupts();
     
-    // 6. 초기 프로세스 생성
-    // process_create("init", init_process, PRIORITY_NORMAL);
+    // 7. 초기 프로세스 생성
+    process_create("init", init_process, PRIORITY_NORMAL);
+    workqueue_init(); // 시스템 작업 큐 작업자 (CPU 수만큼 커널 스레드)
     
-    // 7. 메인 루프
-    while (1) {
-        // 커널 메인 루프
-        // 여기서 시스템 콜 처리, 프로세스 스케줄링 등 수행
-        
-        // 간단한 대기
-        for (volatile int i = 0; i < 1000000; i++) {
-            // CPU 사용량 조절
-        }
-    }
+    // 8. 유휴 루프 (실행할 프로세스가 없으면 다음 타이머 이벤트까지 hlt)
+    scheduler_idle();
 }
 
-// 초기화 프로세스 (간단한 예시)
+// 초기화 프로세스 (종료한 프로세스를 회수, 회수할 것이 없으면 대기 큐에서 잠듦)
 void init_process(void) {
-    // 시스템 초기화 작업
     while (1) {
-        // 초기화 프로세스 루프
-        scheduler_yield();
+        process_destroy(process_reap());
     }
 }
 
@@ -64,8 +73,11 @@ int sys_close(int fd) {
 }
 
 int sys_fork(void) {
-    // 프로세스 포크 구현 (간단한 예시)
-    return -1; // 아직 구현되지 않음
+    // 사용자 메모리는 쓰기 시 복사로 공유, 자식은 같은 지점에서 0을 받고 돌아감
+    process_t* child = process_fork(process_get_current());
+    if (!child) return -1;
+    
+    return (int)child->pid;
 }
 
 int sys_exec(const char* path, char* const argv[]) {
@@ -75,9 +87,61 @@ int sys_exec(const char* path, char* const argv[]) {
     return -1; // 아직 구현되지 않음
 }
 
+int sys_brk(int arg1, int arg2, int arg3) {
+    // 힙 영역 끝 조정 (늘어난 부분은 첫 접근 시 할당, 인자는 시스템 콜 표 형식인 int 세 개)
+    uint32_t new_end = (uint32_t)arg1;
+    (void)arg2;
+    (void)arg3;
+    process_t* process = process_get_current();
+    if (!process || !process->heap_area) return -1;
+    
+    if (new_end == 0) {
+        return (int)process->heap_area->end;
+    }
+    
+    if (vm_area_resize(process->heap_area, new_end, (page_directory_t*)process->cr3) < 0) {
+        return -1;
+    }
+    
+    return (int)process->heap_area->end;
+}
+
+int sys_futex(int arg1, int op, int arg3) {
+    // 시스템 콜 인자가 세 개뿐이라 시간 제한 없이 대기 (시간 제한은 커널 안의 futex_wait만)
+    uint32_t* addr = (uint32_t*)arg1;
+    uint32_t val = (uint32_t)arg3;
+    
+    switch (op) {
+        case FUTEX_WAIT:
+            return futex_wait(addr, val, 0);
+        case FUTEX_WAKE:
+            return futex_wake(addr, val);
+        default:
+            return -1;
+    }
+}
+
+// 사용자 버퍼 [addr, addr + size)가 현재 프로세스의 쓰기 가능한 한 영역 안에 있는지
+static int user_buffer_writable(uint32_t addr, uint32_t size) {
+    process_t* current = process_get_current();
+    if (!current || addr < USER_SPACE_START || addr + size < addr) return 0;
+    
+    vm_area_t* area = vm_area_find(current->vm_areas, addr);
+    return area && (area->flags & PAGE_WRITE) && addr + size <= area->end;
+}
+
+int sys_irqstat(int arg1, int arg2, int arg3) {
+    // 한 벡터의 횟수와 처리 시간 분포 (모든 CPU 합)
+    (void)arg3;
+    if (!user_buffer_writable((uint32_t)arg2, sizeof(irq_stat_t))) return -1;
+    
+    return irq_stat_get((uint32_t)arg1, (irq_stat_t*)arg2);
+}
+
 int sys_exit(int status) {
-    // 프로세스 종료 구현 (간단한 예시)
+    // 현재 프로세스를 좀비로 만들고 다음 프로세스로 전환 (반환하지 않음)
     (void)status;
+    process_exit();
     return 0;
 }
 
@@ -90,6 +154,9 @@ void register_system_calls(void) {
     register_syscall(4, sys_fork);    // fork
     register_syscall(5, sys_exec);    // exec
     register_syscall(6, sys_exit);    // exit
+    register_syscall(7, sys_brk);     // brk
+    register_syscall(8, sys_futex);   // futex
+    register_syscall(9, sys_irqstat); // irqstat
 }
 
 // 커널 초기화 함수
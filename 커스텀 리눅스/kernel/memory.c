@@ -1,110 +1,471 @@
 #include "memory.h"
+#include "buddy.h"
+#include "slab.h"
+#include "scheduler.h"
+#include "spinlock.h"
+#include "interrupt.h"
 #include <string.h>
 
 static memory_manager_t mem_manager;
+static spinlock_t heap_lock = SPINLOCK_INIT;
 
-// 메모리 초기화
-void memory_init(uint32_t start_addr, uint32_t size) {
-    mem_manager.heap_start = start_addr;
-    mem_manager.heap_end = start_addr + size;
+// 커널이 항등 매핑으로 접근하는 물리 메모리 끝
+static uint32_t kernel_memory_end = 0;
+
+// 커널 이미지 범위 (링커 스크립트에서 정의)
+extern char _kernel_start[];
+extern char _kernel_end[];
+
+// 커널 이미지 밖의 사용 가능한 물리 메모리 구간
+static memory_range_t memory_ranges[MEMORY_RANGE_MAX];
+static uint32_t memory_range_count = 0;
+
+// 빈 블록에 저장할 수 있는 최소 데이터 크기
+#define MIN_PAYLOAD_SIZE ((sizeof(free_node_t) + HEAP_ALIGN - 1) & ~(HEAP_ALIGN - 1))
+
+// 블록 하나에 붙는 경계 태그 크기 (헤더 + 푸터)
+#define BLOCK_OVERHEAD (2 * sizeof(memory_block_t))
+
+static uint32_t block_payload(memory_block_t* block) {
+    return (uint32_t)block + sizeof(memory_block_t);
+}
+
+static memory_block_t* payload_to_block(void* ptr) {
+    return (memory_block_t*)((uint32_t)ptr - sizeof(memory_block_t));
+}
+
+static memory_block_t* block_footer(memory_block_t* block) {
+    return (memory_block_t*)(block_payload(block) + block->size);
+}
+
+// 주소상 다음 블록의 헤더
+static memory_block_t* block_next(memory_block_t* block) {
+    return block_footer(block) + 1;
+}
+
+// 주소상 이전 블록의 헤더 (바로 앞 푸터에서 크기를 읽음)
+static memory_block_t* block_prev(memory_block_t* block) {
+    memory_block_t* prev_footer = block - 1;
+    return (memory_block_t*)((uint32_t)prev_footer - prev_footer->size - sizeof(memory_block_t));
+}
+
+// 헤더와 푸터를 함께 기록
+static void block_set(memory_block_t* block, uint32_t size, uint32_t is_allocated) {
+    block->size = size;
+    block->is_allocated = is_allocated;
+    *block_footer(block) = *block;
+}
+
+static free_node_t* block_to_node(memory_block_t* block) {
+    return (free_node_t*)block_payload(block);
+}
+
+static memory_block_t* node_to_block(free_node_t* node) {
+    return payload_to_block(node);
+}
+
+// 빈 블록을 크기 클래스 리스트 또는 큰 블록 트리에 등록
+static void free_block_insert(memory_block_t* block) {
+    free_node_t* node = block_to_node(block);
+    
+    if (block->size < SMALL_BLOCK_MAX) {
+        uint32_t index = block->size >> SIZE_CLASS_SHIFT;
+        
+        node->prev = NULL;
+        node->next = mem_manager.size_class[index];
+        if (node->next) {
+            node->next->prev = node;
+        }
+        mem_manager.size_class[index] = node;
+        mem_manager.class_bitmap[index >> 5] |= 1u << (index & 31);
+        return;
+    }
+    
+    // (크기, 주소) 순서로 트리에 삽입
+    rb_node_t** link = &mem_manager.large_tree.node;
+    rb_node_t* parent = NULL;
+    
+    while (*link) {
+        memory_block_t* other = node_to_block(rb_entry(*link, free_node_t, tree));
+        
+        parent = *link;
+        if (block->size < other->size ||
+            (block->size == other->size && block < other)) {
+            link = &parent->left;
+        } else {
+            link = &parent->right;
+        }
+    }
+    
+    rb_link_node(&node->tree, parent, link);
+    rb_insert_color(&node->tree, &mem_manager.large_tree);
+}
+
+// 빈 블록을 크기 클래스 리스트 또는 큰 블록 트리에서 제거
+static void free_block_remove(memory_block_t* block) {
+    free_node_t* node = block_to_node(block);
+    
+    if (block->size < SMALL_BLOCK_MAX) {
+        uint32_t index = block->size >> SIZE_CLASS_SHIFT;
+        
+        if (node->prev) {
+            node->prev->next = node->next;
+        } else {
+            mem_manager.size_class[index] = node->next;
+        }
+        if (node->next) {
+            node->next->prev = node->prev;
+        }
+        
+        if (!mem_manager.size_class[index]) {
+            mem_manager.class_bitmap[index >> 5] &= ~(1u << (index & 31));
+        }
+        return;
+    }
+    
+    rb_erase(&node->tree, &mem_manager.large_tree);
+}
+
+// 요청 크기 이상인 가장 작은 비어 있지 않은 클래스 찾기 (비트맵 검색, O(1))
+static memory_block_t* find_small_block(uint32_t size) {
+    uint32_t index = size >> SIZE_CLASS_SHIFT;
+    uint32_t word = index >> 5;
+    uint32_t bits = mem_manager.class_bitmap[word] & (~0u << (index & 31));
+    
+    while (!bits) {
+        if (++word >= SIZE_CLASS_BITMAP_WORDS) return NULL;
+        bits = mem_manager.class_bitmap[word];
+    }
+    
+    index = (word << 5) + __builtin_ctz(bits);
+    return node_to_block(mem_manager.size_class[index]);
+}
+
+// 요청 크기 이상인 가장 작은 큰 블록 찾기 (Best Fit)
+static memory_block_t* find_large_block(uint32_t size) {
+    rb_node_t* node = mem_manager.large_tree.node;
+    memory_block_t* best = NULL;
+    
+    while (node) {
+        memory_block_t* block = node_to_block(rb_entry(node, free_node_t, tree));
+        
+        if (block->size >= size) {
+            best = block;
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    
+    return best;
+}
+
+// 힙 초기화
+static void heap_init(uint32_t start_addr, uint32_t size) {
+    memset(&mem_manager, 0, sizeof(mem_manager));
+    
+    // 블록 정렬을 위해 시작 주소를 맞춤
+    uint32_t aligned_start = (start_addr + HEAP_ALIGN - 1) & ~(HEAP_ALIGN - 1);
+    size -= aligned_start - start_addr;
+    size &= ~(HEAP_ALIGN - 1);
+    
+    mem_manager.heap_start = aligned_start;
+    mem_manager.heap_end = aligned_start + size;
     mem_manager.total_memory = size;
     mem_manager.used_memory = 0;
     
+    // 힙 양 끝에 할당된 상태의 경계 태그를 두어 병합 시 범위 검사를 생략
+    memory_block_t* prologue = (memory_block_t*)aligned_start;
+    prologue->size = 0;
+    prologue->is_allocated = 1;
+    
+    memory_block_t* epilogue = (memory_block_t*)(mem_manager.heap_end - sizeof(memory_block_t));
+    epilogue->size = 0;
+    epilogue->is_allocated = 1;
+    
     // 초기 메모리 블록 생성
-    mem_manager.free_list = (memory_block_t*)start_addr;
-    mem_manager.free_list->start_addr = start_addr + sizeof(memory_block_t);
-    mem_manager.free_list->size = size - sizeof(memory_block_t);
-    mem_manager.free_list->is_allocated = 0;
-    mem_manager.free_list->next = NULL;
+    memory_block_t* block = prologue + 1;
+    block_set(block, (uint32_t)epilogue - block_payload(block) - sizeof(memory_block_t), 0);
+    free_block_insert(block);
 }
 
-// 메모리 할당 (First Fit 알고리즘)
-void* kmalloc(size_t size) {
-    if (size == 0) return NULL;
+// 사용 가능 구간 추가 (기존 구간과 겹치는 부분은 제외)
+static void memory_range_add(uint64_t start, uint64_t end) {
+    // 항등 매핑은 ioremap 구간 아래까지 (그 위의 RAM은 사용하지 않음)
+    if (start < LOW_MEMORY_END) start = LOW_MEMORY_END;
+    if (end > IOREMAP_START) end = IOREMAP_START;
     
-    // 4바이트 정렬
-    size = (size + 3) & ~3;
-    
-    memory_block_t* current = mem_manager.free_list;
-    memory_block_t* prev = NULL;
-    
-    while (current != NULL) {
-        if (!current->is_allocated && current->size >= size) {
-            // 블록을 분할할 수 있는지 확인
-            if (current->size > size + sizeof(memory_block_t)) {
-                // 새 블록 생성
-                memory_block_t* new_block = (memory_block_t*)(current->start_addr + size);
-                new_block->start_addr = current->start_addr + size + sizeof(memory_block_t);
-                new_block->size = current->size - size - sizeof(memory_block_t);
-                new_block->is_allocated = 0;
-                new_block->next = current->next;
-                
-                current->size = size;
-                current->next = new_block;
-            }
-            
-            current->is_allocated = 1;
-            mem_manager.used_memory += current->size;
-            
-            return (void*)current->start_addr;
+    start = (start + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
+    end &= ~(uint64_t)(PAGE_SIZE - 1);
+    if (start >= end) return;
+    
+    for (uint32_t i = 0; i < memory_range_count; i++) {
+        memory_range_t* range = &memory_ranges[i];
+        if (start < range->end && end > range->start) {
+            memory_range_add(start, range->start);
+            memory_range_add(range->end, end);
+            return;
         }
-        
-        prev = current;
-        current = current->next;
     }
     
-    return NULL; // 메모리 부족
+    if (memory_range_count >= MEMORY_RANGE_MAX) return;
+    memory_ranges[memory_range_count].start = (uint32_t)start;
+    memory_ranges[memory_range_count].end = (uint32_t)end;
+    memory_range_count++;
 }
 
-// 메모리 해제
-void kfree(void* ptr) {
-    if (ptr == NULL) return;
+// 예약 영역과 겹치는 부분을 사용 가능 구간에서 제거
+static void memory_range_remove(uint64_t start, uint64_t end) {
+    start &= ~(uint64_t)(PAGE_SIZE - 1);
+    end = (end + PAGE_SIZE - 1) & ~(uint64_t)(PAGE_SIZE - 1);
     
-    memory_block_t* current = mem_manager.free_list;
-    memory_block_t* prev = NULL;
+    for (uint32_t i = 0; i < memory_range_count; i++) {
+        memory_range_t* range = &memory_ranges[i];
+        if (start >= range->end || end <= range->start) continue;
+        
+        uint32_t old_end = range->end;
+        if (start > range->start) {
+            // 앞부분은 남기고 뒷부분은 새 구간으로
+            range->end = (uint32_t)start;
+            if (end < old_end && memory_range_count < MEMORY_RANGE_MAX) {
+                memory_ranges[memory_range_count].start = (uint32_t)end;
+                memory_ranges[memory_range_count].end = old_end;
+                memory_range_count++;
+            }
+        } else if (end < old_end) {
+            range->start = (uint32_t)end;
+        } else {
+            // 구간 전체 제거
+            memory_ranges[i] = memory_ranges[--memory_range_count];
+            i--;
+        }
+    }
+}
+
+// 메모리 초기화 (E820 맵의 사용 가능 구간으로 힙과 페이지 프레임 구성)
+void memory_init(const e820_map_t* map) {
+    memory_range_count = 0;
     
-    while (current != NULL) {
-        if ((void*)current->start_addr == ptr) {
-            current->is_allocated = 0;
-            mem_manager.used_memory -= current->size;
-            
-            // 인접한 빈 블록들과 병합
-            if (prev && !prev->is_allocated) {
-                prev->size += current->size + sizeof(memory_block_t);
-                prev->next = current->next;
-                // current 블록은 무효화됨
+    if (map && map->count > 0) {
+        uint32_t count = map->count < E820_MAX_ENTRIES ? map->count : E820_MAX_ENTRIES;
+        
+        for (uint32_t i = 0; i < count; i++) {
+            const e820_entry_t* entry = &map->entries[i];
+            if (entry->type == E820_TYPE_USABLE && (entry->acpi_attributes & E820_ACPI_VALID)) {
+                memory_range_add(entry->base, entry->base + entry->length);
             }
-            
-            if (current->next && !current->next->is_allocated) {
-                current->size += current->next->size + sizeof(memory_block_t);
-                current->next = current->next->next;
+        }
+        
+        // 사용 가능 구간과 겹쳐 보고된 예약 영역은 예약으로 취급
+        for (uint32_t i = 0; i < count; i++) {
+            const e820_entry_t* entry = &map->entries[i];
+            if (entry->type != E820_TYPE_USABLE || !(entry->acpi_attributes & E820_ACPI_VALID)) {
+                memory_range_remove(entry->base, entry->base + entry->length);
             }
-            
-            return;
         }
+    } else {
+        // E820을 지원하지 않는 BIOS: 64MB로 가정
+        memory_range_add(LOW_MEMORY_END, 64 * 1024 * 1024);
+    }
+    
+    // 커널 이미지 제외
+    memory_range_remove((uint32_t)_kernel_start, (uint32_t)_kernel_end);
+    
+    // 가장 큰 구간의 앞부분을 힙으로 사용
+    uint32_t total = 0;
+    memory_range_t* largest = NULL;
+    for (uint32_t i = 0; i < memory_range_count; i++) {
+        uint32_t size = memory_ranges[i].end - memory_ranges[i].start;
+        total += size;
+        if (!largest || size > largest->end - largest->start) {
+            largest = &memory_ranges[i];
+        }
+    }
+    if (!largest) return;
+    
+    uint32_t heap_size = (total / 2) & ~(PAGE_SIZE - 1);
+    if (heap_size > KERNEL_HEAP_SIZE) {
+        heap_size = KERNEL_HEAP_SIZE;
+    }
+    if (heap_size > largest->end - largest->start) {
+        heap_size = largest->end - largest->start;
+    }
+    
+    heap_init(largest->start, heap_size);
+    largest->start += heap_size;
+    
+    // 나머지 구간은 모두 페이지 프레임으로
+    uint32_t low = 0xFFFFFFFF;
+    uint32_t high = 0;
+    for (uint32_t i = 0; i < memory_range_count; i++) {
+        if (memory_ranges[i].start >= memory_ranges[i].end) continue;
+        if (memory_ranges[i].start < low) low = memory_ranges[i].start;
+        if (memory_ranges[i].end > high) high = memory_ranges[i].end;
+    }
+    
+    kernel_memory_end = high > mem_manager.heap_end ? high : mem_manager.heap_end;
+    if (low >= high) return;
+    
+    buddy_init(low, high);
+    for (uint32_t i = 0; i < memory_range_count; i++) {
+        if (memory_ranges[i].start < memory_ranges[i].end) {
+            buddy_add_range(memory_ranges[i].start, memory_ranges[i].end);
+        }
+    }
+}
+
+// 메모리 할당 (크기 클래스 + 큰 블록 Best Fit, heap_lock을 잡은 상태에서 호출)
+static void* heap_alloc(size_t size) {
+    if (size == 0 || size > mem_manager.total_memory) return NULL;
+    
+    // 8바이트 정렬
+    size = (size + HEAP_ALIGN - 1) & ~(HEAP_ALIGN - 1);
+    if (size < MIN_PAYLOAD_SIZE) {
+        size = MIN_PAYLOAD_SIZE;
+    }
+    
+    memory_block_t* block = NULL;
+    if (size < SMALL_BLOCK_MAX) {
+        block = find_small_block(size);
+    }
+    if (!block) {
+        block = find_large_block(size);
+    }
+    if (!block) return NULL; // 메모리 부족
+    
+    free_block_remove(block);
+    
+    // 블록을 분할할 수 있는지 확인
+    uint32_t block_size = block->size;
+    if (block_size >= size + BLOCK_OVERHEAD + MIN_PAYLOAD_SIZE) {
+        block_set(block, size, 1);
         
-        prev = current;
-        current = current->next;
+        // 남은 부분을 새 빈 블록으로
+        memory_block_t* rest = block_next(block);
+        block_set(rest, block_size - size - BLOCK_OVERHEAD, 0);
+        free_block_insert(rest);
+    } else {
+        block_set(block, block_size, 1);
     }
+    
+    mem_manager.used_memory += block->size;
+    
+    return (void*)block_payload(block);
 }
 
-// 정렬된 메모리 할당
-void* kmalloc_aligned(size_t size, size_t alignment) {
-    if (alignment == 0) return kmalloc(size);
+// 메모리 해제 (경계 태그로 헤더를 찾고 양쪽 이웃과 O(1) 병합, heap_lock을 잡은 상태에서 호출)
+static void heap_free(void* ptr) {
+    if (ptr == NULL) return;
+    
+    uint32_t addr = (uint32_t)ptr;
+    if (addr < mem_manager.heap_start + 2 * sizeof(memory_block_t) || addr >= mem_manager.heap_end) return;
+    
+    memory_block_t* block = payload_to_block(ptr);
+    
+    // 잘못된 포인터 또는 이중 해제
+    if (block->is_allocated != 1 || block->size > mem_manager.heap_end - addr ||
+        block_footer(block)->size != block->size) return;
     
-    // 정렬된 크기 계산
-    size_t aligned_size = size + alignment - 1;
-    void* ptr = kmalloc(aligned_size);
+    mem_manager.used_memory -= block->size;
     
+    uint32_t size = block->size;
+    
+    // 다음 블록과 병합
+    memory_block_t* next = block_next(block);
+    if (!next->is_allocated) {
+        free_block_remove(next);
+        size += next->size + BLOCK_OVERHEAD;
+    }
+    
+    // 이전 블록과 병합
+    memory_block_t* prev_footer = block - 1;
+    if (!prev_footer->is_allocated) {
+        memory_block_t* prev = block_prev(block);
+        free_block_remove(prev);
+        size += prev->size + BLOCK_OVERHEAD;
+        block = prev;
+    }
+    
+    block_set(block, size, 0);
+    free_block_insert(block);
+}
+
+// 할당된 블록을 size로 줄이고 남는 뒷부분을 힙에 반환
+static void block_trim(memory_block_t* block, uint32_t size) {
+    uint32_t block_size = block->size;
+    if (block_size < size + BLOCK_OVERHEAD + MIN_PAYLOAD_SIZE) return;
+    
+    block_set(block, size, 1);
+    
+    // 뒷부분을 할당된 블록으로 만든 뒤 heap_free로 이웃과 병합
+    memory_block_t* rest = block_next(block);
+    block_set(rest, block_size - size - BLOCK_OVERHEAD, 1);
+    mem_manager.used_memory -= BLOCK_OVERHEAD;
+    heap_free((void*)block_payload(rest));
+}
+
+// 정렬된 메모리 할당 (앞뒤 여분을 빈 블록으로 돌려주므로 kfree 가능)
+static void* heap_alloc_aligned(size_t size, size_t alignment) {
+    if (alignment <= HEAP_ALIGN) return heap_alloc(size);
+    if (alignment & (alignment - 1)) return NULL;
+    if (size == 0 || size > mem_manager.total_memory) return NULL;
+    
+    size = (size + HEAP_ALIGN - 1) & ~(HEAP_ALIGN - 1);
+    if (size < MIN_PAYLOAD_SIZE) {
+        size = MIN_PAYLOAD_SIZE;
+    }
+    
+    // 앞쪽 여분이 최소 블록 크기 이상이 되도록 여유 있게 할당
+    void* ptr = heap_alloc(size + alignment + BLOCK_OVERHEAD + MIN_PAYLOAD_SIZE);
     if (ptr == NULL) return NULL;
     
-    // 정렬된 주소 계산
-    uintptr_t addr = (uintptr_t)ptr;
-    uintptr_t aligned_addr = (addr + alignment - 1) & ~(alignment - 1);
+    memory_block_t* block = payload_to_block(ptr);
+    uint32_t addr = (uint32_t)ptr;
+    uint32_t aligned_addr = (addr + alignment - 1) & ~(alignment - 1);
+    
+    if (aligned_addr != addr) {
+        // 앞쪽 틈에 빈 블록이 들어가지 않으면 다음 정렬 위치 사용
+        if (aligned_addr - addr < BLOCK_OVERHEAD + MIN_PAYLOAD_SIZE) {
+            aligned_addr += alignment;
+        }
+        
+        // 앞부분을 별도 블록으로 분리해 힙에 반환
+        uint32_t total = block->size;
+        uint32_t lead = aligned_addr - addr - BLOCK_OVERHEAD;
+        
+        block_set(block, lead, 1);
+        block = payload_to_block((void*)aligned_addr);
+        block_set(block, total - lead - BLOCK_OVERHEAD, 1);
+        mem_manager.used_memory -= BLOCK_OVERHEAD;
+        heap_free(ptr);
+    }
+    
+    block_trim(block, size);
     
     return (void*)aligned_addr;
 }
 
+// 힙은 모든 CPU가 공유하므로 공개 함수에서 잠금
+void* kmalloc(size_t size) {
+    uint32_t flags = spin_lock_irqsave(&heap_lock);
+    void* ptr = heap_alloc(size);
+    spin_unlock_irqrestore(&heap_lock, flags);
+    return ptr;
+}
+
+void kfree(void* ptr) {
+    uint32_t flags = spin_lock_irqsave(&heap_lock);
+    heap_free(ptr);
+    spin_unlock_irqrestore(&heap_lock, flags);
+}
+
+void* kmalloc_aligned(size_t size, size_t alignment) {
+    uint32_t flags = spin_lock_irqsave(&heap_lock);
+    void* ptr = heap_alloc_aligned(size, alignment);
+    spin_unlock_irqrestore(&heap_lock, flags);
+    return ptr;
+}
+
 // 메모리 통계 출력
 void memory_dump_stats(void) {
     // 간단한 통계 출력 (실제 구현에서는 콘솔 출력 함수 필요)
@@ -131,66 +492,611 @@ uint32_t get_free_memory(void) {
 }
 
 // 페이징 시스템 구현
-static page_directory_t* current_page_directory = NULL;
+static page_directory_t* kernel_page_directory = NULL;     // 커널 PDE의 원본
+static kmem_cache_t* vm_area_cache = NULL;
+static uint32_t large_pages_enabled = 0;
+static uint32_t kernel_page_global = 0;     // 커널 매핑에 붙일 PAGE_GLOBAL (PGE 지원 시)
+static uint32_t ioremap_next = KERNEL_SPACE_END;  // 다음 ioremap 구간의 끝
+static spinlock_t ioremap_lock = SPINLOCK_INIT;
 
-void paging_init(void) {
-    // 페이지 디렉토리 생성
-    current_page_directory = (page_directory_t*)kmalloc_aligned(sizeof(page_directory_t), PAGE_SIZE);
-    memset(current_page_directory, 0, sizeof(page_directory_t));
+// 프로세스 디렉토리 목록 (커널 PDE가 바뀌면 모든 디렉토리에 같은 값을 씀)
+typedef struct page_directory_link {
+    page_directory_t* dir;
+    struct page_directory_link* next;
+} page_directory_link_t;
+
+static page_directory_link_t* page_directories = NULL;
+static kmem_cache_t* page_directory_link_cache = NULL;
+static spinlock_t page_directories_lock = SPINLOCK_INIT;   // 목록과 커널 PDE 변경 보호
+
+// PDE 설정 (커널 PDE는 원본과 모든 프로세스 디렉토리에, 사용자 PDE는 그 디렉토리에만)
+// 커널 PDE는 page_directories_lock을 잡고 호출
+static void pde_set(page_directory_t* dir, uint32_t index, uint32_t value) {
+    if (index >= KERNEL_PDE_COUNT || !kernel_page_directory) {
+        dir->entries[index].value = value;
+        return;
+    }
     
-    // 페이지 디렉토리 활성화
-    switch_page_directory(current_page_directory);
+    kernel_page_directory->entries[index].value = value;
+    for (page_directory_link_t* link = page_directories; link; link = link->next) {
+        link->dir->entries[index].value = value;
+    }
 }
 
-void map_page(uint32_t virtual_addr, uint32_t physical_addr, uint32_t flags) {
+// 4MB 페이지를 같은 매핑의 4KB 페이지 테이블로 분할 (커널 PDE면 모든 디렉토리가 새 테이블을 공유)
+static int split_large_page(page_directory_t* dir, uint32_t index) {
+    page_table_t* page_table = (page_table_t*)page_alloc(0);
+    if (!page_table) return -1;
+    
+    uint32_t flags = spin_lock_irqsave(&page_directories_lock);
+    uint32_t value = dir->entries[index].value;
+    
+    // 다른 CPU가 먼저 분할했으면 그 테이블 사용
+    if (!(value & PAGE_LARGE)) {
+        spin_unlock_irqrestore(&page_directories_lock, flags);
+        page_free(page_table, 0);
+        return 0;
+    }
+    
+    uint32_t base = value & ~(LARGE_PAGE_SIZE - 1);
+    uint32_t pte_flags = value & (PAGE_PRESENT | PAGE_WRITE | PAGE_USER | PAGE_GLOBAL);
+    for (uint32_t i = 0; i < 1024; i++) {
+        page_table->entries[i].value = (base + i * PAGE_SIZE) | pte_flags;
+    }
+    
+    pde_set(dir, index, (uint32_t)page_table | (value & (PAGE_PRESENT | PAGE_WRITE | PAGE_USER)));
+    spin_unlock_irqrestore(&page_directories_lock, flags);
+    return 0;
+}
+
+// TLB 전체 비우기 (커널 영역은 전역 페이지이므로 CR4.PGE를 껐다 켬)
+static void tlb_flush_all(int include_global) {
+    if (include_global && kernel_page_global) {
+        uint32_t cr4;
+        __asm__ volatile("mov %%cr4, %0" : "=r" (cr4));
+        __asm__ volatile("mov %0, %%cr4" : : "r" (cr4 & ~CR4_PGE) : "memory");
+        __asm__ volatile("mov %0, %%cr4" : : "r" (cr4) : "memory");
+    } else {
+        uint32_t cr3;
+        __asm__ volatile("mov %%cr3, %0" : "=r" (cr3));
+        __asm__ volatile("mov %0, %%cr3" : : "r" (cr3) : "memory");
+    }
+}
+
+// 범위의 TLB 무효화 (페이지가 많으면 하나씩 invlpg 하지 않고 전체 비우기)
+static void tlb_flush_range(uint32_t start, uint32_t end) {
+    if ((end - start) / PAGE_SIZE > TLB_FLUSH_THRESHOLD) {
+        tlb_flush_all(start < USER_SPACE_START);
+        return;
+    }
+    
+    for (uint32_t addr = start; addr < end; addr += PAGE_SIZE) {
+        __asm__ volatile("invlpg (%0)" : : "r" (addr) : "memory");
+    }
+}
+
+// 가상 주소의 페이지 테이블 엔트리 (create가 0이면 테이블을 만들지 않음)
+static page_table_entry_t* get_page_entry(page_directory_t* dir, uint32_t virtual_addr, int create) {
     uint32_t page_dir_index = virtual_addr >> 22;
     uint32_t page_table_index = (virtual_addr >> 12) & 0x3FF;
     
     // 페이지 테이블이 없으면 생성
-    if (!(current_page_directory->entries[page_dir_index].value & PAGE_PRESENT)) {
-        page_table_t* page_table = (page_table_t*)kmalloc_aligned(sizeof(page_table_t), PAGE_SIZE);
+    if (!(dir->entries[page_dir_index].value & PAGE_PRESENT)) {
+        if (!create) return NULL;
+        
+        page_table_t* page_table = (page_table_t*)page_alloc(0);
+        if (!page_table) return NULL;
         memset(page_table, 0, sizeof(page_table_t));
         
-        current_page_directory->entries[page_dir_index].value = 
-            (uint32_t)page_table | PAGE_PRESENT | PAGE_WRITE;
+        // 사용자 영역 테이블은 PTE에서 권한을 제한하도록 PDE는 넓게 허용
+        // (커널 PDE는 paging_init이 모두 만들어 두므로 여기서는 부팅 중에만)
+        uint32_t flags = spin_lock_irqsave(&page_directories_lock);
+        pde_set(dir, page_dir_index, (uint32_t)page_table | PAGE_PRESENT | PAGE_WRITE |
+                (virtual_addr >= USER_SPACE_START ? PAGE_USER : 0));
+        spin_unlock_irqrestore(&page_directories_lock, flags);
     }
     
+    // 4MB 페이지 안의 한 페이지만 바꾸려면 먼저 분할
+    if (dir->entries[page_dir_index].value & PAGE_LARGE) {
+        if (split_large_page(dir, page_dir_index) < 0) return NULL;
+    }
+    
+    page_table_t* page_table = (page_table_t*)(dir->entries[page_dir_index].value & ~0xFFF);
+    return &page_table->entries[page_table_index];
+}
+
+// 이 CPU가 편집하는 디렉토리 (CR3, 페이징을 켜기 전에는 만들고 있는 커널 디렉토리)
+// 다른 CPU가 마지막으로 전환한 디렉토리가 아니라 이 CPU의 주소 공간을 고치도록
+static page_directory_t* active_page_directory(void) {
+    uint32_t cr0;
+    __asm__ volatile("mov %%cr0, %0" : "=r" (cr0));
+    return (cr0 & CR0_PG) ? page_directory_current() : kernel_page_directory;
+}
+
+void paging_init(void) {
+    vm_area_cache = kmem_cache_create("vm_area", sizeof(vm_area_t), 0, NULL);
+    page_directory_link_cache = kmem_cache_create("page_directory_link", sizeof(page_directory_link_t), 0, NULL);
+    
+    // 커널 디렉토리 생성 (커널 PDE를 모두 채우기 전이므로 아직 다른 디렉토리는 만들지 않음)
+    kernel_page_directory = page_directory_create();
+    
+    // 4MB 페이지(PSE)와 전역 페이지(PGE) 지원 확인
+    uint32_t eax, ebx, ecx, edx;
+    __asm__ volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (1));
+    
+    uint32_t cr4;
+    __asm__ volatile("mov %%cr4, %0" : "=r" (cr4));
+    if (edx & CPUID_FEATURE_PSE) {
+        cr4 |= CR4_PSE;
+        large_pages_enabled = 1;
+    }
+    if (edx & CPUID_FEATURE_PGE) {
+        cr4 |= CR4_PGE;
+        kernel_page_global = PAGE_GLOBAL;
+    }
+    __asm__ volatile("mov %0, %%cr4" : : "r" (cr4) : "memory");
+    
+    // 커널 이미지, 힙, 페이지 프레임을 항등 매핑 (NULL 페이지는 제외)
+    // 첫 4MB는 4KB 페이지, 나머지 정렬된 구간은 4MB 페이지로 매핑됨
+    map_range(PAGE_SIZE, PAGE_SIZE, kernel_memory_end - PAGE_SIZE,
+              PAGE_PRESENT | PAGE_WRITE | kernel_page_global);
+    
+    // 커널 영역의 페이지 테이블을 모두 미리 만들어 둠
+    // (프로세스 디렉토리는 이 PDE를 복사하므로 이후 추가되는 커널 매핑도 공유됨)
+    for (uint32_t i = 0; i < KERNEL_PDE_COUNT; i++) {
+        if (!(kernel_page_directory->entries[i].value & PAGE_PRESENT)) {
+            get_page_entry(kernel_page_directory, i << 22, 1);
+        }
+    }
+    
+    // 페이지 디렉토리 활성화
+    switch_page_directory(kernel_page_directory);
+}
+
+void map_page(uint32_t virtual_addr, uint32_t physical_addr, uint32_t flags) {
+    page_table_entry_t* entry = get_page_entry(active_page_directory(), virtual_addr, 1);
+    if (!entry) return;
+    
     // 페이지 테이블 엔트리 설정
-    page_table_t* page_table = (page_table_t*)(current_page_directory->entries[page_dir_index].value & ~0xFFF);
-    page_table->entries[page_table_index].value = physical_addr | flags;
+    entry->value = physical_addr | flags;
     
     // TLB 무효화
     __asm__ volatile("invlpg (%0)" : : "r" (virtual_addr) : "memory");
 }
 
+// 페이지 디렉토리 생성 (커널 PDE는 공유 테이블을 가리키고 사용자 영역은 비어 있음)
+// 프로세스 디렉토리는 목록에 넣어 이후의 커널 PDE 변경도 받음
+page_directory_t* page_directory_create(void) {
+    page_directory_t* dir = (page_directory_t*)page_alloc(0);
+    if (!dir) return NULL;
+    
+    if (!kernel_page_directory) {
+        memset(dir, 0, sizeof(page_directory_t));
+        return dir;
+    }
+    
+    page_directory_link_t* link = (page_directory_link_t*)kmem_cache_alloc(page_directory_link_cache);
+    if (!link) {
+        page_free(dir, 0);
+        return NULL;
+    }
+    link->dir = dir;
+    memset(&dir->entries[KERNEL_PDE_COUNT], 0, (1024 - KERNEL_PDE_COUNT) * sizeof(page_table_entry_t));
+    
+    // 복사와 목록 추가 사이에 커널 PDE가 바뀌지 않도록 같은 잠금 아래에서
+    uint32_t flags = spin_lock_irqsave(&page_directories_lock);
+    memcpy(dir->entries, kernel_page_directory->entries, KERNEL_PDE_COUNT * sizeof(page_table_entry_t));
+    link->next = page_directories;
+    page_directories = link;
+    spin_unlock_irqrestore(&page_directories_lock, flags);
+    return dir;
+}
+
+// 커널 영역만 매핑된 디렉토리 (종료한 프로세스의 디렉토리에서 벗어날 때 사용)
+page_directory_t* page_directory_kernel(void) {
+    return kernel_page_directory;
+}
+
+// 이 CPU가 사용 중인 디렉토리 (CR3)
+page_directory_t* page_directory_current(void) {
+    page_directory_t* dir;
+    __asm__ volatile("mov %%cr3, %0" : "=r" (dir));
+    return dir;
+}
+
+// 페이지 디렉토리와 사용자 영역 페이지 테이블 해제 (공유 커널 테이블은 유지)
+void page_directory_destroy(page_directory_t* dir) {
+    if (!dir || dir == kernel_page_directory) return;
+    
+    // 이 CPU가 아직 이 디렉토리를 로드하고 있으면 커널 디렉토리로 전환 (유휴 문맥은
+    // 항상 커널 디렉토리에서 실행하므로 다른 CPU는 이 디렉토리를 로드하고 있지 않음)
+    if (dir == page_directory_current()) {
+        switch_page_directory(kernel_page_directory);
+    }
+    
+    // 더 이상 커널 PDE 변경을 받지 않도록 목록에서 제거
+    page_directory_link_t* link = NULL;
+    uint32_t flags = spin_lock_irqsave(&page_directories_lock);
+    for (page_directory_link_t** prev = &page_directories; *prev; prev = &(*prev)->next) {
+        if ((*prev)->dir == dir) {
+            link = *prev;
+            *prev = link->next;
+            break;
+        }
+    }
+    spin_unlock_irqrestore(&page_directories_lock, flags);
+    if (link) {
+        kmem_cache_free(page_directory_link_cache, link);
+    }
+    
+    for (int i = KERNEL_PDE_COUNT; i < 1024; i++) {
+        // 4MB 페이지 엔트리는 페이지 테이블을 가지지 않음
+        if ((dir->entries[i].value & PAGE_PRESENT) && !(dir->entries[i].value & PAGE_LARGE)) {
+            page_free((void*)(dir->entries[i].value & ~0xFFF), 0);
+        }
+    }
+    
+    page_free(dir, 0);
+}
+
 void unmap_page(uint32_t virtual_addr) {
-    uint32_t page_dir_index = virtual_addr >> 22;
-    uint32_t page_table_index = (virtual_addr >> 12) & 0x3FF;
+    page_table_entry_t* entry = get_page_entry(active_page_directory(), virtual_addr, 0);
     
-    if (current_page_directory->entries[page_dir_index].value & PAGE_PRESENT) {
-        page_table_t* page_table = (page_table_t*)(current_page_directory->entries[page_dir_index].value & ~0xFFF);
-        page_table->entries[page_table_index].value = 0;
+    if (entry) {
+        entry->value = 0;
         
-        // TLB 무효화
+        // TLB 무효화 (전역 페이지도 invlpg로 제거됨)
         __asm__ volatile("invlpg (%0)" : : "r" (virtual_addr) : "memory");
     }
 }
 
+// 현재 주소부터 같은 4MB 구간 안에서 처리할 크기
+static uint32_t range_chunk(uint32_t addr, uint32_t end) {
+    uint32_t chunk = LARGE_PAGE_SIZE - (addr & (LARGE_PAGE_SIZE - 1));
+    return chunk < end - addr ? chunk : end - addr;
+}
+
+// 연속 범위 매핑 (페이지 테이블은 4MB 구간마다 한 번만 찾고 TLB는 마지막에 한 번에 무효화)
+void map_range(uint32_t virtual_addr, uint32_t physical_addr, uint32_t size, uint32_t flags) {
+    uint32_t start = virtual_addr & ~(PAGE_SIZE - 1);
+    uint32_t end = (virtual_addr + size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    uint32_t addr = start;
+    page_directory_t* dir = active_page_directory();
+    
+    physical_addr &= ~(PAGE_SIZE - 1);
+    
+    while (addr < end) {
+        uint32_t chunk = range_chunk(addr, end);
+        page_table_entry_t* pde = &dir->entries[addr >> 22];
+        
+        if (large_pages_enabled && chunk == LARGE_PAGE_SIZE &&
+            !(physical_addr & (LARGE_PAGE_SIZE - 1)) &&
+            (!(pde->value & PAGE_PRESENT) || (pde->value & PAGE_LARGE))) {
+            // 정렬된 4MB 구간 전체는 큰 페이지 하나로
+            uint32_t lock_flags = spin_lock_irqsave(&page_directories_lock);
+            pde_set(dir, addr >> 22, physical_addr | flags | PAGE_LARGE);
+            spin_unlock_irqrestore(&page_directories_lock, lock_flags);
+        } else {
+            page_table_entry_t* entry = get_page_entry(dir, addr, 1);
+            if (!entry) break; // 메모리 부족
+            
+            for (uint32_t offset = 0; offset < chunk; offset += PAGE_SIZE) {
+                entry->value = (physical_addr + offset) | flags;
+                entry++;
+            }
+        }
+        
+        addr += chunk;
+        physical_addr += chunk;
+    }
+    
+    tlb_flush_range(start, addr);
+}
+
+// 연속 범위 매핑 해제
+void unmap_range(uint32_t virtual_addr, uint32_t size) {
+    uint32_t start = virtual_addr & ~(PAGE_SIZE - 1);
+    uint32_t end = (virtual_addr + size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    page_directory_t* dir = active_page_directory();
+    
+    for (uint32_t addr = start; addr < end; ) {
+        uint32_t chunk = range_chunk(addr, end);
+        page_table_entry_t* pde = &dir->entries[addr >> 22];
+        
+        if ((pde->value & PAGE_LARGE) && chunk == LARGE_PAGE_SIZE) {
+            uint32_t flags = spin_lock_irqsave(&page_directories_lock);
+            pde_set(dir, addr >> 22, 0);
+            spin_unlock_irqrestore(&page_directories_lock, flags);
+        } else if (pde->value & PAGE_PRESENT) {
+            page_table_entry_t* entry = get_page_entry(dir, addr, 0);
+            for (uint32_t offset = 0; entry && offset < chunk; offset += PAGE_SIZE) {
+                entry->value = 0;
+                entry++;
+            }
+        }
+        
+        addr += chunk;
+    }
+    
+    tlb_flush_range(start, end);
+}
+
+// 연속 범위의 접근 권한 변경 (PAGE_WRITE, PAGE_USER만 바뀜)
+void protect_range(uint32_t virtual_addr, uint32_t size, uint32_t flags) {
+    uint32_t start = virtual_addr & ~(PAGE_SIZE - 1);
+    uint32_t end = (virtual_addr + size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    uint32_t mask = PAGE_WRITE | PAGE_USER;
+    page_directory_t* dir = active_page_directory();
+    
+    flags &= mask;
+    
+    for (uint32_t addr = start; addr < end; ) {
+        uint32_t chunk = range_chunk(addr, end);
+        page_table_entry_t* pde = &dir->entries[addr >> 22];
+        
+        if ((pde->value & PAGE_LARGE) && chunk == LARGE_PAGE_SIZE) {
+            uint32_t lock_flags = spin_lock_irqsave(&page_directories_lock);
+            pde_set(dir, addr >> 22, (pde->value & ~mask) | flags);
+            spin_unlock_irqrestore(&page_directories_lock, lock_flags);
+        } else if (pde->value & PAGE_PRESENT) {
+            page_table_entry_t* entry = get_page_entry(dir, addr, 0);
+            for (uint32_t offset = 0; entry && offset < chunk; offset += PAGE_SIZE) {
+                if (entry->value & PAGE_PRESENT) {
+                    entry->value = (entry->value & ~mask) | flags;
+                }
+                entry++;
+            }
+        }
+        
+        addr += chunk;
+    }
+    
+    tlb_flush_range(start, end);
+}
+
+// 물리 주소를 커널 영역에 매핑 (항등 매핑 밖의 장치 레지스터, ACPI 테이블)
+// 공유 커널 페이지 테이블에 새 매핑만 추가하므로 다른 CPU의 TLB는 비우지 않아도 됨
+void* ioremap(uint32_t physical_addr, uint32_t size) {
+    if (size == 0) return NULL;
+    
+    // 이미 항등 매핑된 RAM은 그대로 사용
+    if (physical_addr >= PAGE_SIZE && physical_addr + size <= kernel_memory_end &&
+        physical_addr + size > physical_addr) {
+        return (void*)physical_addr;
+    }
+    
+    uint32_t offset = physical_addr & (PAGE_SIZE - 1);
+    uint32_t length = (offset + size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    
+    uint32_t flags = spin_lock_irqsave(&ioremap_lock);
+    if (length > ioremap_next - IOREMAP_START || ioremap_next - length < kernel_memory_end) {
+        spin_unlock_irqrestore(&ioremap_lock, flags);
+        return NULL;
+    }
+    ioremap_next -= length;
+    uint32_t virtual_addr = ioremap_next;
+    spin_unlock_irqrestore(&ioremap_lock, flags);
+    
+    map_range(virtual_addr, physical_addr - offset, length,
+              PAGE_PRESENT | PAGE_WRITE | PAGE_CACHE_DISABLE | kernel_page_global);
+    return (void*)(virtual_addr + offset);
+}
+
+// ioremap 해제 (가장 최근 매핑이면 구간도 돌려받음, 잠깐 읽고 버리는 매핑용)
+// 다른 CPU의 TLB는 비우지 않으므로 AP를 깨우기 전이나 그 CPU들이 쓰지 않은 매핑에만
+void iounmap(void* addr, uint32_t size) {
+    uint32_t virtual_addr = (uint32_t)addr;
+    if (!addr || virtual_addr < IOREMAP_START || virtual_addr >= KERNEL_SPACE_END) return; // 항등 매핑
+    
+    uint32_t offset = virtual_addr & (PAGE_SIZE - 1);
+    uint32_t length = (offset + size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    virtual_addr -= offset;
+    unmap_range(virtual_addr, length);
+    
+    uint32_t flags = spin_lock_irqsave(&ioremap_lock);
+    if (virtual_addr == ioremap_next) {
+        ioremap_next += length;
+    }
+    spin_unlock_irqrestore(&ioremap_lock, flags);
+}
+
+// 디렉토리에서 가상 주소가 매핑된 물리 주소 (매핑되지 않았으면 0)
+uint32_t virtual_to_physical(page_directory_t* dir, uint32_t virtual_addr) {
+    page_table_entry_t* pde = &dir->entries[virtual_addr >> 22];
+    if (!(pde->value & PAGE_PRESENT)) return 0;
+    
+    // 4MB 페이지는 분할하지 않고 그대로 계산
+    if (pde->value & PAGE_LARGE) {
+        return (pde->value & ~0x3FFFFF) | (virtual_addr & 0x3FFFFF);
+    }
+    
+    page_table_t* page_table = (page_table_t*)(pde->value & ~0xFFF);
+    page_table_entry_t* entry = &page_table->entries[(virtual_addr >> 12) & 0x3FF];
+    if (!(entry->value & PAGE_PRESENT)) return 0;
+    
+    return (entry->value & ~0xFFF) | (virtual_addr & 0xFFF);
+}
+
 void switch_page_directory(page_directory_t* dir) {
-    current_page_directory = dir;
     __asm__ volatile("mov %0, %%cr3" : : "r" (dir) : "memory");
     
-    // 페이징 활성화
+    // 페이징 활성화 (이미 켜져 있으면 생략)
     uint32_t cr0;
     __asm__ volatile("mov %%cr0, %0" : "=r" (cr0));
-    cr0 |= 0x80000000; // PG 비트 설정
-    __asm__ volatile("mov %0, %%cr0" : : "r" (cr0) : "memory");
+    if (!(cr0 & CR0_PG)) {
+        cr0 |= CR0_PG;
+        __asm__ volatile("mov %0, %%cr0" : : "r" (cr0) : "memory");
+    }
+}
+
+// 쓰기 시 복사 폴트 처리 (공유 중이면 복사, 마지막 참조면 그대로 쓰기 허용, 메모리 부족이면 -1)
+static int cow_fault(page_table_entry_t* entry, vm_area_t* area) {
+    void* frame = (void*)(entry->value & ~0xFFF);
+    
+    if (page_ref_count(frame) > 1) {
+        void* copy = page_alloc(0);
+        if (!copy) return -1;
+        memcpy(copy, frame, PAGE_SIZE);
+        
+        page_put(frame);
+        frame = copy;
+    }
+    
+    entry->value = (uint32_t)frame | PAGE_PRESENT | area->flags;
+    return 0;
+}
+
+// 해결할 수 없는 페이지 폴트 (돌아가면 같은 명령에서 다시 폴트가 나므로 돌아가지 않음)
+// 사용자 영역 주소면 커널 모드에서 났어도 (잘못된 시스템 콜 인자) 현재 프로세스만 종료
+static void page_fault_fatal(interrupt_context_t* context, uint32_t fault_addr) {
+    if (fault_addr >= USER_SPACE_START && process_get_current()) {
+        process_exit();
+    }
+    exception_fatal(context);
 }
 
-void page_fault_handler(void) {
+// 페이지 폴트 처리 (VMA 안의 첫 접근이면 0으로 채운 프레임을 할당해 매핑)
+void page_fault_handler(interrupt_context_t* context) {
     uint32_t fault_addr;
     __asm__ volatile("mov %%cr2, %0" : "=r" (fault_addr));
     
-    // 페이지 폴트 처리 (실제 구현에서는 더 복잡)
-    (void)fault_addr;
+    process_t* process = process_get_current();
+    vm_area_t* area = process ? vm_area_find(process->vm_areas, fault_addr) : NULL;
+    
+    if (!area) {
+        page_fault_fatal(context, fault_addr);
+    }
+    
+    // 폴트가 난 주소 공간은 현재 CR3의 디렉토리
+    page_directory_t* dir = page_directory_current();
+    
+    uint32_t page = fault_addr & ~(PAGE_SIZE - 1);
+    page_table_entry_t* entry = get_page_entry(dir, page, 1);
+    if (!entry) {
+        page_fault_fatal(context, fault_addr);
+    }
+    
+    if (entry->value & PAGE_PRESENT) {
+        // 공유된 읽기 전용 페이지에 대한 쓰기 (쓰기 시 복사가 아니면 권한 위반)
+        if (!(entry->value & PAGE_COW) || cow_fault(entry, area) < 0) {
+            page_fault_fatal(context, fault_addr);
+        }
+    } else {
+        void* frame = page_alloc(0);
+        if (!frame) {
+            page_fault_fatal(context, fault_addr);
+        }
+        memset(frame, 0, PAGE_SIZE);
+        
+        entry->value = (uint32_t)frame | PAGE_PRESENT | area->flags;
+    }
+    __asm__ volatile("invlpg (%0)" : : "r" (page) : "memory");
+}
+
+// 영역 범위에 매핑된 프레임 해제
+static void vm_area_release_pages(page_directory_t* dir, uint32_t start, uint32_t end) {
+    if (!dir) return;
+    
+    for (uint32_t addr = start; addr < end; addr += PAGE_SIZE) {
+        page_table_entry_t* entry = get_page_entry(dir, addr, 0);
+        if (entry && (entry->value & PAGE_PRESENT)) {
+            page_put((void*)(entry->value & ~0xFFF));
+            entry->value = 0;
+        }
+    }
+    
+    if (dir == page_directory_current()) {
+        tlb_flush_range(start, end);
+    }
+}
+
+// 가상 메모리 영역 생성 (프레임은 첫 접근 시 할당)
+vm_area_t* vm_area_create(vm_area_t** areas, uint32_t start, uint32_t size, uint32_t flags) {
+    uint32_t end = (start + size + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    start &= ~(PAGE_SIZE - 1);
+    if (end < start) return NULL;
+    
+    // 시작 주소 순서 유지, 겹치는 영역 거부
+    vm_area_t** link = areas;
+    while (*link && (*link)->start < start) {
+        if ((*link)->end > start) return NULL;
+        link = &(*link)->next;
+    }
+    if (*link && (*link)->start < end) return NULL;
+    
+    vm_area_t* area = (vm_area_t*)kmem_cache_alloc(vm_area_cache);
+    if (!area) return NULL;
+    
+    area->start = start;
+    area->end = end;
+    area->flags = flags;
+    area->next = *link;
+    *link = area;
+    
+    return area;
+}
+
+// 주소를 포함하는 영역 찾기
+vm_area_t* vm_area_find(vm_area_t* areas, uint32_t addr) {
+    for (vm_area_t* area = areas; area && area->start <= addr; area = area->next) {
+        if (addr < area->end) {
+            return area;
+        }
+    }
+    return NULL;
+}
+
+// 영역 끝 조정 (줄어든 부분의 프레임은 해제)
+int vm_area_resize(vm_area_t* area, uint32_t new_end, page_directory_t* dir) {
+    new_end = (new_end + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+    if (new_end < area->start) return -1;
+    if (area->next && new_end > area->next->start) return -1;
+    
+    if (new_end < area->end) {
+        vm_area_release_pages(dir, new_end, area->end);
+    }
+    
+    area->end = new_end;
+    return 0;
+}
+
+// 영역과 매핑을 복제 (쓰기 가능한 페이지는 양쪽 모두 읽기 전용으로 공유)
+int vm_area_fork(vm_area_t** dst_areas, page_directory_t* dst, vm_area_t* src_areas, page_directory_t* src) {
+    for (vm_area_t* area = src_areas; area; area = area->next) {
+        if (!vm_area_create(dst_areas, area->start, area->end - area->start, area->flags)) {
+            return -1;
+        }
+        
+        for (uint32_t addr = area->start; addr < area->end; addr += PAGE_SIZE) {
+            page_table_entry_t* entry = get_page_entry(src, addr, 0);
+            if (!entry || !(entry->value & PAGE_PRESENT)) continue;
+            
+            page_table_entry_t* child = get_page_entry(dst, addr, 1);
+            if (!child) return -1;
+            
+            if (entry->value & PAGE_WRITE) {
+                entry->value = (entry->value & ~PAGE_WRITE) | PAGE_COW;
+            }
+            child->value = entry->value;
+            page_get((void*)(entry->value & ~0xFFF));
+        }
+    }
+    
+    // 부모의 쓰기 권한이 줄었으므로 TLB 비우기
+    if (src == page_directory_current()) {
+        tlb_flush_all(0);
+    }
+    
+    return 0;
+}
+
+// 모든 영역과 매핑된 프레임 해제
+void vm_area_destroy_all(vm_area_t** areas, page_directory_t* dir) {
+    while (*areas) {
+        vm_area_t* area = *areas;
+        *areas = area->next;
+        
+        vm_area_release_pages(dir, area->start, area->end);
+        kmem_cache_free(vm_area_cache, area);
+    }
 }
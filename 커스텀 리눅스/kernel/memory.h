@@ -3,18 +3,72 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "rbtree.h"
 
-// 메모리 블록 구조체
+struct interrupt_context;
+
+// 힙 할당 단위와 크기 클래스
+#define HEAP_ALIGN 8
+#define SIZE_CLASS_SHIFT 3                                        // 클래스 간격 8바이트
+#define SIZE_CLASS_COUNT 128                                      // 작은 블록 클래스 수
+#define SMALL_BLOCK_MAX (SIZE_CLASS_COUNT << SIZE_CLASS_SHIFT)    // 이 크기 이상은 트리 사용
+#define SIZE_CLASS_BITMAP_WORDS (SIZE_CLASS_COUNT / 32)
+
+// 힙 최대 크기 (나머지 메모리는 페이지 프레임 할당기가 관리)
+#define KERNEL_HEAP_SIZE (8 * 1024 * 1024)
+
+// 커널 주소 공간 (하위 1GB에서 ioremap 구간을 뺀 곳을 항등 매핑으로 사용, 1MB 미만은 BIOS/부트로더 영역)
+#define LOW_MEMORY_END 0x100000
+#define KERNEL_SPACE_END 0x40000000
+
+// 커널 영역 꼭대기에서 장치 MMIO와 ACPI 테이블을 매핑하는 구간 (위에서부터 아래로 할당)
+#define IOREMAP_SIZE (16 * 1024 * 1024)
+#define IOREMAP_START (KERNEL_SPACE_END - IOREMAP_SIZE)
+
+// BIOS E820 메모리 맵 (Stage 2가 보호 모드 전환 전에 수집, stage2.asm과 주소 일치)
+#define E820_MAP_ADDR 0x5000
+#define E820_MAX_ENTRIES 64
+#define E820_TYPE_USABLE 1
+#define E820_ACPI_VALID 0x1
+
+typedef struct {
+    uint64_t base;
+    uint64_t length;
+    uint32_t type;
+    uint32_t acpi_attributes;
+} __attribute__((packed)) e820_entry_t;
+
+typedef struct {
+    uint32_t count;
+    e820_entry_t entries[E820_MAX_ENTRIES];
+} __attribute__((packed)) e820_map_t;
+
+// 사용 가능한 물리 메모리 구간
+#define MEMORY_RANGE_MAX (E820_MAX_ENTRIES * 2)
+
+typedef struct {
+    uint32_t start;
+    uint32_t end;
+} memory_range_t;
+
+// 메모리 블록 경계 태그 (블록 앞의 헤더와 블록 끝의 푸터에 같은 내용 저장)
 typedef struct memory_block {
-    uint32_t start_addr;
-    uint32_t size;
-    int is_allocated;
-    struct memory_block* next;
+    uint32_t size;                  // 데이터 영역 크기
+    uint32_t is_allocated;
 } memory_block_t;
 
+// 빈 블록 노드 (빈 블록의 데이터 영역에 저장)
+typedef struct free_node {
+    struct free_node* next;         // 같은 크기 클래스의 다음 빈 블록
+    struct free_node* prev;         // 같은 크기 클래스의 이전 빈 블록
+    rb_node_t tree;                 // 큰 블록 트리 노드
+} free_node_t;
+
 // 메모리 관리자 구조체
 typedef struct memory_manager {
-    memory_block_t* free_list;
+    free_node_t* size_class[SIZE_CLASS_COUNT];          // 크기 클래스별 빈 리스트
+    uint32_t class_bitmap[SIZE_CLASS_BITMAP_WORDS];     // 비어 있지 않은 클래스 비트맵
+    rb_root_t large_tree;                               // 큰 빈 블록 (크기, 주소) 트리
     uint32_t total_memory;
     uint32_t used_memory;
     uint32_t heap_start;
@@ -22,7 +76,7 @@ typedef struct memory_manager {
 } memory_manager_t;
 
 // 메모리 관리 함수들
-void memory_init(uint32_t start_addr, uint32_t size);
+void memory_init(const e820_map_t* map);
 void* kmalloc(size_t size);
 void kfree(void* ptr);
 void* kmalloc_aligned(size_t size, size_t alignment);
@@ -36,6 +90,21 @@ uint32_t get_free_memory(void);
 #define PAGE_PRESENT 0x1
 #define PAGE_WRITE 0x2
 #define PAGE_USER 0x4
+#define PAGE_CACHE_DISABLE 0x10     // 장치 레지스터 (캐시하지 않음)
+#define PAGE_LARGE 0x80             // PDE의 4MB 페이지 (PS 비트)
+#define PAGE_GLOBAL 0x100           // CR3를 다시 로드해도 TLB에 유지
+#define PAGE_COW 0x200              // 쓰기 시 복사 (운영체제용 비트 9)
+#define LARGE_PAGE_SIZE 0x400000
+
+// 이보다 많은 페이지를 바꾸면 invlpg 대신 TLB 전체 비우기
+#define TLB_FLUSH_THRESHOLD 32
+
+// CPUID 1번 기능 비트 (EDX)와 CR0/CR4 비트
+#define CPUID_FEATURE_PSE (1 << 3)
+#define CPUID_FEATURE_PGE (1 << 13)
+#define CR0_PG 0x80000000
+#define CR4_PSE 0x10
+#define CR4_PGE 0x80
 
 typedef struct page_table_entry {
     uint32_t value;
@@ -49,11 +118,43 @@ typedef struct page_directory {
     page_table_entry_t entries[1024];
 } page_directory_t;
 
+// 사용자 주소 공간 배치 (커널 1GB 위)
+#define USER_SPACE_START KERNEL_SPACE_END
+#define KERNEL_PDE_COUNT (KERNEL_SPACE_END >> 22)    // 모든 디렉토리가 공유하는 커널 PDE 수
+#define USER_HEAP_START 0x50000000
+#define USER_STACK_TOP 0xC0000000
+#define USER_STACK_SIZE (1024 * 1024)
+
+// 가상 메모리 영역 (첫 접근 시 0으로 채운 프레임을 할당)
+typedef struct vm_area {
+    uint32_t start;                 // 시작 주소 (페이지 정렬)
+    uint32_t end;                   // 끝 주소 (페이지 정렬, 미포함)
+    uint32_t flags;                 // 매핑할 페이지 플래그 (PAGE_WRITE, PAGE_USER)
+    struct vm_area* next;           // 시작 주소 순 다음 영역
+} vm_area_t;
+
 // 페이징 함수들
 void paging_init(void);
+page_directory_t* page_directory_create(void);
+page_directory_t* page_directory_kernel(void);
+page_directory_t* page_directory_current(void);
+void page_directory_destroy(page_directory_t* dir);
 void map_page(uint32_t virtual_addr, uint32_t physical_addr, uint32_t flags);
 void unmap_page(uint32_t virtual_addr);
+void map_range(uint32_t virtual_addr, uint32_t physical_addr, uint32_t size, uint32_t flags);
+void unmap_range(uint32_t virtual_addr, uint32_t size);
+void protect_range(uint32_t virtual_addr, uint32_t size, uint32_t flags);
+void* ioremap(uint32_t physical_addr, uint32_t size);
+void iounmap(void* addr, uint32_t size);
+uint32_t virtual_to_physical(page_directory_t* dir, uint32_t virtual_addr);
 void switch_page_directory(page_directory_t* dir);
-void page_fault_handler(void);
+void page_fault_handler(struct interrupt_context* context);
+
+// 가상 메모리 영역 함수들
+vm_area_t* vm_area_create(vm_area_t** areas, uint32_t start, uint32_t size, uint32_t flags);
+vm_area_t* vm_area_find(vm_area_t* areas, uint32_t addr);
+int vm_area_resize(vm_area_t* area, uint32_t new_end, page_directory_t* dir);
+void vm_area_destroy_all(vm_area_t** areas, page_directory_t* dir);
+int vm_area_fork(vm_area_t** dst_areas, page_directory_t* dst, vm_area_t* src_areas, page_directory_t* src);
 
 #endif // MEMORY_H
@@ -0,0 +1,61 @@
+#include "pit.h"
+
+// I/O 포트
+#define PIT_CHANNEL0 0x40
+#define PIT_CHANNEL2 0x42
+#define PIT_COMMAND 0x43
+#define PIT_PORT_B 0x61             // 비트 0: 채널 2 게이트, 비트 1: 스피커, 비트 5: 채널 2 출력
+
+// 명령 바이트 (채널 0, 하위/상위 바이트 순서로 접근)
+#define PIT_CMD_LATCH 0x00          // 현재 카운터 값 래치
+#define PIT_CMD_ONESHOT 0x30        // 모드 0 (0이 되면 한 번 인터럽트)
+#define PIT_CMD_PERIODIC 0x36       // 모드 3 (구형파, 주기 인터럽트)
+#define PIT_CMD_CH2_ONESHOT 0xB0    // 채널 2, 모드 0
+
+static void pit_write(uint8_t command, uint32_t count) {
+    __asm__ volatile("outb %0, %1" : : "a" (command), "Nd" (PIT_COMMAND));
+    __asm__ volatile("outb %0, %1" : : "a" ((uint8_t)(count & 0xFF)), "Nd" (PIT_CHANNEL0));
+    __asm__ volatile("outb %0, %1" : : "a" ((uint8_t)((count >> 8) & 0xFF)), "Nd" (PIT_CHANNEL0));
+}
+
+// 주기 모드 (초당 frequency번 인터럽트)
+void pit_set_periodic(uint32_t frequency) {
+    pit_write(PIT_CMD_PERIODIC, PIT_FREQUENCY / frequency);
+}
+
+// 단발 모드 (count 클럭 뒤에 한 번만 인터럽트)
+void pit_set_oneshot(uint32_t count) {
+    pit_write(PIT_CMD_ONESHOT, count);
+}
+
+// 채널 0 카운터의 남은 값
+uint32_t pit_read_count(void) {
+    uint8_t low, high;
+    
+    __asm__ volatile("outb %0, %1" : : "a" ((uint8_t)PIT_CMD_LATCH), "Nd" (PIT_COMMAND));
+    __asm__ volatile("inb %1, %0" : "=a" (low) : "Nd" (PIT_CHANNEL0));
+    __asm__ volatile("inb %1, %0" : "=a" (high) : "Nd" (PIT_CHANNEL0));
+    
+    return ((uint32_t)high << 8) | low;
+}
+
+// 채널 2를 count 클럭 단발 모드로 시작 (스피커는 끄고 게이트만 올림)
+void pit_channel2_start(uint32_t count) {
+    uint8_t port_b;
+    
+    __asm__ volatile("inb %1, %0" : "=a" (port_b) : "Nd" (PIT_PORT_B));
+    port_b = (port_b & ~0x02) | 0x01;
+    __asm__ volatile("outb %0, %1" : : "a" (port_b), "Nd" (PIT_PORT_B));
+    
+    __asm__ volatile("outb %0, %1" : : "a" ((uint8_t)PIT_CMD_CH2_ONESHOT), "Nd" (PIT_COMMAND));
+    __asm__ volatile("outb %0, %1" : : "a" ((uint8_t)(count & 0xFF)), "Nd" (PIT_CHANNEL2));
+    __asm__ volatile("outb %0, %1" : : "a" ((uint8_t)((count >> 8) & 0xFF)), "Nd" (PIT_CHANNEL2));
+}
+
+// 채널 2 카운터가 0에 도달했는지 (모드 0은 도달하면 출력이 올라감)
+int pit_channel2_expired(void) {
+    uint8_t port_b;
+    
+    __asm__ volatile("inb %1, %0" : "=a" (port_b) : "Nd" (PIT_PORT_B));
+    return (port_b & 0x20) != 0;
+}
@@ -0,0 +1,19 @@
+#ifndef PIT_H
+#define PIT_H
+
+#include <stdint.h>
+
+// PIT 입력 클럭과 카운터 한계 (16비트)
+#define PIT_FREQUENCY 1193180
+#define PIT_MAX_COUNT 0xFFFF
+
+// PIT 채널 0 함수들 (IRQ 0)
+void pit_set_periodic(uint32_t frequency);
+void pit_set_oneshot(uint32_t count);
+uint32_t pit_read_count(void);
+
+// PIT 채널 2 함수들 (인터럽트 없이 출력 핀을 폴링, 보정용)
+void pit_channel2_start(uint32_t count);
+int pit_channel2_expired(void);
+
+#endif // PIT_H
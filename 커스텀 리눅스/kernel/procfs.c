@@ -0,0 +1,92 @@
+#include "procfs.h"
+#include "memory.h"
+#include "spinlock.h"
+#include <string.h>
+
+typedef struct {
+    const char* name;               // PROC_PREFIX 뒤의 이름
+    proc_show_t show;
+} proc_entry_t;
+
+static proc_entry_t entries[PROC_MAX_ENTRIES];
+static uint32_t entry_count = 0;
+static spinlock_t entries_lock = SPINLOCK_INIT;
+
+// 가상 파일 등록 (항목 번호 반환, 가득 찼으면 -1)
+int proc_create(const char* name, proc_show_t show) {
+    if (!name || !show) return -1;
+    
+    uint32_t flags = spin_lock_irqsave(&entries_lock);
+    if (entry_count == PROC_MAX_ENTRIES) {
+        spin_unlock_irqrestore(&entries_lock, flags);
+        return -1;
+    }
+    
+    int entry = (int)entry_count;
+    entries[entry].name = name;
+    entries[entry].show = show;
+    entry_count++;
+    spin_unlock_irqrestore(&entries_lock, flags);
+    return entry;
+}
+
+// 경로에 해당하는 항목 번호 (/proc 파일이 아니면 -1)
+int proc_lookup(const char* path) {
+    uint32_t prefix = sizeof(PROC_PREFIX) - 1;
+    if (!path || strncmp(path, PROC_PREFIX, prefix) != 0) return -1;
+    
+    for (uint32_t i = 0; i < entry_count; i++) {
+        if (strcmp(path + prefix, entries[i].name) == 0) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+// offset부터 최대 size바이트 읽기 (읽은 바이트 수, 끝이면 0)
+int proc_read(int entry, uint32_t offset, void* buffer, uint32_t size) {
+    if (entry < 0 || (uint32_t)entry >= entry_count || !buffer) return -1;
+    
+    proc_buffer_t content;
+    content.data = (char*)kmalloc(PROC_BUFFER_SIZE);
+    if (!content.data) return -1;
+    content.size = PROC_BUFFER_SIZE;
+    content.length = 0;
+    
+    entries[entry].show(&content);
+    
+    uint32_t count = 0;
+    if (offset < content.length) {
+        count = content.length - offset;
+        if (count > size) count = size;
+        memcpy(buffer, content.data + offset, count);
+    }
+    
+    kfree(content.data);
+    return (int)count;
+}
+
+void proc_puts(proc_buffer_t* buffer, const char* text) {
+    while (*text && buffer->length < buffer->size) {
+        buffer->data[buffer->length++] = *text++;
+    }
+}
+
+// 10진수를 width 칸에 오른쪽 정렬
+void proc_put_uint(proc_buffer_t* buffer, uint32_t value, uint32_t width) {
+    char digits[11];
+    uint32_t count = 0;
+    
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    
+    while (width > count && buffer->length < buffer->size) {
+        buffer->data[buffer->length++] = ' ';
+        width--;
+    }
+    while (count && buffer->length < buffer->size) {
+        buffer->data[buffer->length++] = digits[--count];
+    }
+}
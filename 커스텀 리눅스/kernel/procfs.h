@@ -0,0 +1,31 @@
+#ifndef PROCFS_H
+#define PROCFS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// /proc 가상 파일 (읽을 때마다 내용을 새로 만듦, 쓰기는 지원하지 않음)
+
+#define PROC_PREFIX "/proc/"
+#define PROC_MAX_ENTRIES 16
+#define PROC_BUFFER_SIZE 16384      // 한 번에 만드는 내용의 최대 크기 (넘치면 잘림)
+
+// 내용을 만드는 버퍼
+typedef struct {
+    char* data;
+    uint32_t size;
+    uint32_t length;
+} proc_buffer_t;
+
+typedef void (*proc_show_t)(proc_buffer_t* buffer);
+
+// procfs 함수들
+int proc_create(const char* name, proc_show_t show);
+int proc_lookup(const char* path);
+int proc_read(int entry, uint32_t offset, void* buffer, uint32_t size);
+
+// 내용 작성 함수들
+void proc_puts(proc_buffer_t* buffer, const char* text);
+void proc_put_uint(proc_buffer_t* buffer, uint32_t value, uint32_t width);
+
+#endif // PROCFS_H
@@ -0,0 +1,274 @@
+#include "rbtree.h"
+
+// 왼쪽 회전
+static void rb_rotate_left(rb_node_t* x, rb_root_t* root) {
+    rb_node_t* y = x->right;
+    
+    x->right = y->left;
+    if (y->left) {
+        y->left->parent = x;
+    }
+    
+    y->parent = x->parent;
+    if (!x->parent) {
+        root->node = y;
+    } else if (x == x->parent->left) {
+        x->parent->left = y;
+    } else {
+        x->parent->right = y;
+    }
+    
+    y->left = x;
+    x->parent = y;
+}
+
+// 오른쪽 회전
+static void rb_rotate_right(rb_node_t* x, rb_root_t* root) {
+    rb_node_t* y = x->left;
+    
+    x->left = y->right;
+    if (y->right) {
+        y->right->parent = x;
+    }
+    
+    y->parent = x->parent;
+    if (!x->parent) {
+        root->node = y;
+    } else if (x == x->parent->right) {
+        x->parent->right = y;
+    } else {
+        x->parent->left = y;
+    }
+    
+    y->right = x;
+    x->parent = y;
+}
+
+static int rb_is_black(const rb_node_t* node) {
+    return !node || node->color == RB_BLACK;
+}
+
+// 삽입 후 균형 복구
+void rb_insert_color(rb_node_t* node, rb_root_t* root) {
+    rb_node_t* parent;
+    
+    while ((parent = node->parent) && parent->color == RB_RED) {
+        // 빨간 부모는 루트가 아니므로 조부모가 항상 존재
+        rb_node_t* gparent = parent->parent;
+        
+        if (parent == gparent->left) {
+            rb_node_t* uncle = gparent->right;
+            
+            if (uncle && uncle->color == RB_RED) {
+                uncle->color = RB_BLACK;
+                parent->color = RB_BLACK;
+                gparent->color = RB_RED;
+                node = gparent;
+                continue;
+            }
+            
+            if (node == parent->right) {
+                rb_rotate_left(parent, root);
+                node = parent;
+                parent = node->parent;
+            }
+            
+            parent->color = RB_BLACK;
+            gparent->color = RB_RED;
+            rb_rotate_right(gparent, root);
+        } else {
+            rb_node_t* uncle = gparent->left;
+            
+            if (uncle && uncle->color == RB_RED) {
+                uncle->color = RB_BLACK;
+                parent->color = RB_BLACK;
+                gparent->color = RB_RED;
+                node = gparent;
+                continue;
+            }
+            
+            if (node == parent->left) {
+                rb_rotate_right(parent, root);
+                node = parent;
+                parent = node->parent;
+            }
+            
+            parent->color = RB_BLACK;
+            gparent->color = RB_RED;
+            rb_rotate_left(gparent, root);
+        }
+    }
+    
+    root->node->color = RB_BLACK;
+}
+
+// u 자리에 v 서브트리 연결
+static void rb_transplant(rb_node_t* u, rb_node_t* v, rb_root_t* root) {
+    if (!u->parent) {
+        root->node = v;
+    } else if (u == u->parent->left) {
+        u->parent->left = v;
+    } else {
+        u->parent->right = v;
+    }
+    
+    if (v) {
+        v->parent = u->parent;
+    }
+}
+
+// 삭제 후 균형 복구 (x는 NULL일 수 있으므로 부모를 따로 전달)
+static void rb_erase_fixup(rb_node_t* x, rb_node_t* parent, rb_root_t* root) {
+    while (x != root->node && rb_is_black(x)) {
+        if (x == parent->left) {
+            rb_node_t* sibling = parent->right;
+            
+            if (sibling->color == RB_RED) {
+                sibling->color = RB_BLACK;
+                parent->color = RB_RED;
+                rb_rotate_left(parent, root);
+                sibling = parent->right;
+            }
+            
+            if (rb_is_black(sibling->left) && rb_is_black(sibling->right)) {
+                sibling->color = RB_RED;
+                x = parent;
+                parent = x->parent;
+            } else {
+                if (rb_is_black(sibling->right)) {
+                    sibling->left->color = RB_BLACK;
+                    sibling->color = RB_RED;
+                    rb_rotate_right(sibling, root);
+                    sibling = parent->right;
+                }
+                
+                sibling->color = parent->color;
+                parent->color = RB_BLACK;
+                sibling->right->color = RB_BLACK;
+                rb_rotate_left(parent, root);
+                x = root->node;
+                break;
+            }
+        } else {
+            rb_node_t* sibling = parent->left;
+            
+            if (sibling->color == RB_RED) {
+                sibling->color = RB_BLACK;
+                parent->color = RB_RED;
+                rb_rotate_right(parent, root);
+                sibling = parent->left;
+            }
+            
+            if (rb_is_black(sibling->left) && rb_is_black(sibling->right)) {
+                sibling->color = RB_RED;
+                x = parent;
+                parent = x->parent;
+            } else {
+                if (rb_is_black(sibling->left)) {
+                    sibling->right->color = RB_BLACK;
+                    sibling->color = RB_RED;
+                    rb_rotate_left(sibling, root);
+                    sibling = parent->left;
+                }
+                
+                sibling->color = parent->color;
+                parent->color = RB_BLACK;
+                sibling->left->color = RB_BLACK;
+                rb_rotate_right(parent, root);
+                x = root->node;
+                break;
+            }
+        }
+    }
+    
+    if (x) {
+        x->color = RB_BLACK;
+    }
+}
+
+// 노드 삭제
+void rb_erase(rb_node_t* node, rb_root_t* root) {
+    rb_node_t* child;
+    rb_node_t* parent;
+    int removed_color = node->color;
+    
+    if (!node->left) {
+        child = node->right;
+        parent = node->parent;
+        rb_transplant(node, node->right, root);
+    } else if (!node->right) {
+        child = node->left;
+        parent = node->parent;
+        rb_transplant(node, node->left, root);
+    } else {
+        // 후속 노드로 대체
+        rb_node_t* successor = node->right;
+        while (successor->left) {
+            successor = successor->left;
+        }
+        
+        removed_color = successor->color;
+        child = successor->right;
+        
+        if (successor->parent == node) {
+            parent = successor;
+        } else {
+            parent = successor->parent;
+            rb_transplant(successor, successor->right, root);
+            successor->right = node->right;
+            successor->right->parent = successor;
+        }
+        
+        rb_transplant(node, successor, root);
+        successor->left = node->left;
+        successor->left->parent = successor;
+        successor->color = node->color;
+    }
+    
+    if (removed_color == RB_BLACK) {
+        rb_erase_fixup(child, parent, root);
+    }
+}
+
+// 가장 작은 노드
+rb_node_t* rb_first(const rb_root_t* root) {
+    rb_node_t* node = root->node;
+    
+    if (!node) return NULL;
+    
+    while (node->left) {
+        node = node->left;
+    }
+    
+    return node;
+}
+
+// 가장 큰 노드
+rb_node_t* rb_last(const rb_root_t* root) {
+    rb_node_t* node = root->node;
+    
+    if (!node) return NULL;
+    
+    while (node->right) {
+        node = node->right;
+    }
+    
+    return node;
+}
+
+// 중위 순회상 다음 노드
+rb_node_t* rb_next(const rb_node_t* node) {
+    if (node->right) {
+        node = node->right;
+        while (node->left) {
+            node = node->left;
+        }
+        return (rb_node_t*)node;
+    }
+    
+    while (node->parent && node == node->parent->right) {
+        node = node->parent;
+    }
+    
+    return node->parent;
+}
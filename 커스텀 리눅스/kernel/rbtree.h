@@ -0,0 +1,48 @@
+#ifndef RBTREE_H
+#define RBTREE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 레드-블랙 트리 색상
+#define RB_RED 0
+#define RB_BLACK 1
+
+// 레드-블랙 트리 노드 (다른 구조체 안에 포함해서 사용)
+typedef struct rb_node {
+    struct rb_node* parent;
+    struct rb_node* left;
+    struct rb_node* right;
+    int color;
+} rb_node_t;
+
+// 레드-블랙 트리 루트
+typedef struct rb_root {
+    rb_node_t* node;
+} rb_root_t;
+
+// 노드를 포함한 구조체 포인터 얻기
+#define rb_entry(ptr, type, member) \
+    ((type*)((char*)(ptr) - offsetof(type, member)))
+
+// 트리에 속하지 않은 노드 표시와 검사 (부모를 자기 자신으로)
+#define RB_CLEAR_NODE(node) ((node)->parent = (node))
+#define RB_EMPTY_NODE(node) ((node)->parent == (node))
+
+// 탐색으로 찾은 위치에 새 노드 연결 (이후 rb_insert_color 호출 필요)
+static inline void rb_link_node(rb_node_t* node, rb_node_t* parent, rb_node_t** link) {
+    node->parent = parent;
+    node->left = NULL;
+    node->right = NULL;
+    node->color = RB_RED;
+    *link = node;
+}
+
+// 레드-블랙 트리 함수들
+void rb_insert_color(rb_node_t* node, rb_root_t* root);
+void rb_erase(rb_node_t* node, rb_root_t* root);
+rb_node_t* rb_first(const rb_root_t* root);
+rb_node_t* rb_last(const rb_root_t* root);
+rb_node_t* rb_next(const rb_node_t* node);
+
+#endif // RBTREE_H
@@ -1,412 +1,1861 @@
 #include "scheduler.h"
 #include "memory.h"
 #include "interrupt.h"
+#include "slab.h"
+#include "buddy.h"
+#include "timer.h"
+#include "gdt.h"
+#include "fpu.h"
+#include "smp.h"
+#include "pit.h"
+#include "apic.h"
+#include "tsc.h"
+#include "wait.h"
+#include "irqstat.h"
+#include "softirq.h"
 #include <string.h>
 
-static scheduler_t scheduler;
-static uint32_t timer_ticks = 0;
-static uint32_t timer_frequency = 100; // 100Hz
+#define PROCESS_STACK_SIZE PAGE_SIZE
 
-// 스케줄러 초기화
+static kmem_cache_t* process_cache = NULL;
+static uint32_t next_pid = 1;           // 모든 CPU가 원자적으로 증가
+static uint32_t total_processes = 0;
+static uint32_t timer_ticks = 0;        // CPU 0의 틱이 갱신
+static uint32_t timer_frequency = 1000; // 1kHz (1틱 = 1ms)
+
+// 회수를 기다리는 좀비 프로세스 (큐 잠금으로 보호, init이 process_reap으로 꺼내 해제)
+static process_t* zombie_queue = NULL;
+static wait_queue_t zombie_wait = WAIT_QUEUE_INIT;
+
+#define SCHED_TICK_INTERVAL 10  // 다른 CPU에 선점 틱을 보내는 간격 (10ms)
+static uint32_t kick_next = SCHED_TICK_INTERVAL; // 다음에 다른 CPU에 선점 틱을 보낼 틱
+
+// 공정 정책 매개변수 (us)
+#define FAIR_LATENCY 20000              // 준비된 공정 프로세스가 모두 한 번씩 실행되는 목표 주기
+#define FAIR_MIN_GRANULARITY 4000       // 선점되기 전 최소 실행 시간
+#define FAIR_WAKEUP_GRANULARITY 2000    // 깨어난 프로세스가 선점하려면 앞서야 하는 vruntime 차이
+#define FAIR_WEIGHT_NORMAL 1024         // PRIORITY_NORMAL의 가중치 (vruntime이 실제 시간과 같이 증가)
+
+// 우선순위별 가중치 (한 단계 높을 때마다 CPU 몫이 약 3배)
+static const uint32_t fair_weights[PRIORITY_LEVELS] = { 335, 1024, 3121, 9548 };
+
+// 마감 정책 대역폭 (runtime/period를 16비트 고정소수점으로)
+#define DL_BW_SHIFT 16
+#define DL_BW_LIMIT ((95 << DL_BW_SHIFT) / 100)    // CPU마다 95%까지 (나머지는 다른 클래스 몫)
+#define DL_PERIOD_MAX 0xFFFF                        // 대역폭 계산이 32비트를 넘지 않는 최대 주기 (틱)
+
+static spinlock_t dl_bw_lock = SPINLOCK_INIT;
+static uint32_t dl_total_bw = 0;        // 승인된 마감 프로세스의 대역폭 합 (dl_bw_lock으로 보호)
+
+// 로드 평균 (LOAD_FREQ초마다 CPU 0이 갱신)
+#define LOAD_FREQ 5                     // 갱신 간격 (초)
+#define EXP_1 1884                      // FIXED_1 / exp(5초 / 1분)
+#define EXP_5 2014                      // FIXED_1 / exp(5초 / 5분)
+#define EXP_15 2037                     // FIXED_1 / exp(5초 / 15분)
+
+static uint32_t load_averages[3] = { 0, 0, 0 };
+static uint32_t load_next_update = 0;   // 다음 갱신 틱
+
+// 유휴 상태에서 주기 틱을 멈추고 단발 모드로 설정한 틱 수 (0이면 주기 모드)
+static uint32_t oneshot_ticks = 0;
+static uint32_t oneshot_counts = 0;     // 단발 모드로 설정한 카운트 (끝나는 시점은 항상 틱 경계)
+static uint32_t tick_partial = 0;       // 마지막 틱 경계 뒤로 지난 카운트 (단발 모드에서만)
+
+// 틱 장치 (Local APIC 타이머를 보정했으면 CPU마다 자기 타이머, 아니면 CPU 0의 PIT)
+static int lapic_tick = 0;
+static uint32_t tick_counts = 0;        // 한 틱의 카운트
+static uint32_t tick_max_count = 0;     // 단발 모드로 설정할 수 있는 최대 카운트
+
+// 새 프로세스의 정책 (정책을 비교할 때 커널을 고치지 않고 바꿀 수 있도록)
+static sched_policy_t default_policy = SCHED_FAIR;
+
+static const sched_class_t* policy_class(sched_policy_t policy) {
+    switch (policy) {
+        case SCHED_FAIR:
+            return &fair_sched_class;
+        case SCHED_DEADLINE:
+            return &deadline_sched_class;
+        default:
+            return &priority_sched_class;
+    }
+}
+
+static void dl_timer_expired(void* data);
+static void sleep_locked(scheduler_t* rq, process_t* process, uint32_t ticks);
+static void timer_interrupt(interrupt_frame_t* frame);
+static void timer_softirq(void);
+
+// 마감 정책 대역폭 반납 (정책을 바꿀 때, 멈춘 프로세스의 보충 타이머는 dl_dequeue가 취소)
+static void dl_return_bw(process_t* process) {
+    uint32_t flags = spin_lock_irqsave(&dl_bw_lock);
+    dl_total_bw -= process->dl_bw;
+    process->dl_bw = 0;
+    spin_unlock_irqrestore(&dl_bw_lock, flags);
+}
+
+// 종료할 때 대역폭 반납 (이미 시작된 보충 타이머 콜백이 끝날 때까지 기다리므로 rq 잠금 없이 호출)
+static void dl_release_bw(process_t* process) {
+    kernel_timer_cancel_sync(&process->dl_timer);
+    dl_return_bw(process);
+}
+
+// 이 CPU의 스케줄러 (인터럽트를 끈 상태에서 사용)
+static scheduler_t* this_rq(void) {
+    return &smp_this_cpu()->sched;
+}
+
+// 프로세스가 속한 CPU의 스케줄러를 잠금 (잠그는 사이 다른 CPU로 옮겨졌으면 다시 시도)
+static scheduler_t* process_rq_lock(process_t* process, uint32_t* flags) {
+    for (;;) {
+        scheduler_t* rq = &smp_get_cpu(process->cpu)->sched;
+        *flags = spin_lock_irqsave(&rq->lock);
+        if (rq == &smp_get_cpu(process->cpu)->sched) return rq;
+        spin_unlock_irqrestore(&rq->lock, *flags);
+    }
+}
+
+// 새 커널 스택에 첫 전환용 프레임 구성 (switch_stacks가 꺼내고 process_trampoline으로 복귀)
+static void process_init_stack(process_t* process, void (*entry_point)(void)) {
+    uint32_t* stack = (uint32_t*)process->stack_top;
+    stack[-1] = (uint32_t)entry_point;        // 진입 함수 (process_trampoline이 호출)
+    stack[-2] = (uint32_t)process_trampoline; // 복귀 주소
+    stack[-3] = 0;                            // EBP
+    stack[-4] = 0;                            // EBX
+    stack[-5] = 0;                            // ESI
+    stack[-6] = 0;                            // EDI
+    
+    process->esp = (uint32_t)&stack[-6];
+    process->ebp = 0;
+    process->eip = (uint32_t)entry_point;
+}
+
+// fork한 자식의 커널 스택 (부모의 시스템 콜 트랩 프레임을 스택 맨 위의 같은 위치에 복사)
+// 자식은 fork_trampoline에서 부모와 같은 복귀 경로로 가서 반환값 0으로 시스템 콜을 마침
+static void process_init_fork_stack(process_t* child, process_t* parent) {
+    uint32_t size = parent->stack_top - parent->trap_frame;
+    uint32_t frame = child->stack_top - size;
+    memcpy((void*)frame, (void*)parent->trap_frame, size);
+    *(uint32_t*)(frame + parent->trap_eax_offset) = 0;
+    child->trap_frame = frame;
+    
+    uint32_t* stack = (uint32_t*)frame;
+    stack[-1] = (uint32_t)parent->trap_return; // 복귀 경로 (fork_trampoline이 ret으로 이동)
+    stack[-2] = (uint32_t)fork_trampoline;     // 복귀 주소
+    stack[-3] = 0;                             // EBP
+    stack[-4] = 0;                             // EBX
+    stack[-5] = 0;                             // ESI
+    stack[-6] = 0;                             // EDI
+    
+    child->esp = (uint32_t)&stack[-6];
+    child->ebp = 0;
+}
+
+// 스케줄러 초기화 (BSP의 스케줄러, AP의 스케줄러는 smp_init에서)
 void scheduler_init(void) {
-    memset(&scheduler, 0, sizeof(scheduler_t));
-    scheduler.current_process = NULL;
-    scheduler.ready_queue = NULL;
-    scheduler.blocked_queue = NULL;
-    scheduler.sleeping_queue = NULL;
-    scheduler.next_pid = 1;
-    scheduler.total_processes = 0;
-    scheduler.time_quantum = 10; // 10ms
+    scheduler_init_cpu(this_rq());
+    
+    // 프로세스 구조체 캐시
+    process_cache = kmem_cache_create("process", sizeof(process_t), 0, NULL);
     
     // 타이머 초기화
+    timer_wheel_init(timer_ticks);
     timer_init(timer_frequency);
+    load_next_update = timer_ticks + LOAD_FREQ * timer_frequency;
 }
 
-// 프로세스 생성
-process_t* process_create(const char* name, void (*entry_point)(void), priority_t priority) {
-    process_t* process = (process_t*)kmalloc(sizeof(process_t));
+// CPU별 스케줄러 초기화
+void scheduler_init_cpu(scheduler_t* rq) {
+    memset(rq, 0, sizeof(scheduler_t));
+    spin_lock_init(&rq->lock);
+    rq->current_process = NULL;
+    rq->blocked_queue = NULL;
+    rq->sleeping_queue = NULL;
+    rq->time_quantum = 10; // 10ms
+    rq->clock_stamp = tsc_khz ? tsc_read() : 0;
+}
+
+// 프로세스 할당과 초기화 (준비 큐에는 넣지 않음)
+static process_t* process_alloc(const char* name, void (*entry_point)(void), priority_t priority) {
+    process_t* process = (process_t*)kmem_cache_alloc(process_cache);
     if (!process) return NULL;
     
     // 프로세스 초기화
-    process->pid = scheduler.next_pid++;
+    process->pid = __sync_fetch_and_add(&next_pid, 1);
     strncpy(process->name, name, 31);
     process->name[31] = '\0';
     process->state = PROCESS_READY;
     process->priority = priority;
-    process->time_slice = scheduler.time_quantum;
+    process->policy = default_policy;
+    process->sched_class = policy_class(default_policy);
+    process->on_rq = 0;
+    process->slice_start = 0;
+    process->exec_start = 0;
     process->total_time = 0;
+    process->utime = 0;
+    process->stime = 0;
+    process->vruntime = 0;              // 준비 큐에 넣을 때 그 CPU의 min_vruntime 근처로
+    RB_CLEAR_NODE(&process->run_node);
+    process->dl_bw = 0;
+    process->dl_throttled = 0;
+    kernel_timer_init(&process->dl_timer);
     process->next = NULL;
     process->prev = NULL;
+    process->queue = NULL;
+    process->fpu_state = NULL;
+    process->fpu_cpu = SMP_NO_CPU;
+    process->cpu = smp_cpu_id();
+    process->last_cpu = SMP_NO_CPU;
+    process->affinity = SMP_ALL_CPUS;
+    process->trap_frame = 0;
+    process->trap_eax_offset = 0;
+    process->trap_return = NULL;
+    process->kthread_fn = NULL;
+    process->kthread_data = NULL;
+    kernel_timer_init(&process->sleep_timer);
     
     // 스택 할당 (4KB)
-    process->stack_bottom = (uint32_t)kmalloc(4096);
-    process->stack_top = process->stack_bottom + 4096;
-    process->esp = process->stack_top - 16; // 스택 정렬
-    process->ebp = process->esp;
+    process->stack_bottom = (uint32_t)page_alloc(0);
+    if (!process->stack_bottom) {
+        kmem_cache_free(process_cache, process);
+        return NULL;
+    }
+    process->stack_top = process->stack_bottom + PROCESS_STACK_SIZE;
+    process_init_stack(process, entry_point);
     
-    // 스택에 초기 컨텍스트 설정
-    uint32_t* stack = (uint32_t*)process->stack_top;
-    stack[-1] = (uint32_t)entry_point; // EIP
-    stack[-2] = 0x202;                 // EFLAGS (IF=1, IOPL=0)
-    stack[-3] = 0x10;                  // CS (커널 코드 세그먼트)
-    stack[-4] = 0;                     // EAX
-    stack[-5] = 0;                     // ECX
-    stack[-6] = 0;                     // EDX
-    stack[-7] = 0;                     // EBX
-    stack[-8] = 0;                     // ESP (원래 스택)
-    stack[-9] = 0;                     // EBP
-    stack[-10] = 0;                    // ESI
-    stack[-11] = 0;                    // EDI
-    
-    process->esp = (uint32_t)&stack[-11];
-    
-    // 페이지 디렉토리 생성 (간단한 구현)
-    process->cr3 = (uint32_t)kmalloc_aligned(4096, 4096);
+    // 페이지 디렉토리 생성 (커널 영역은 공유 페이지 테이블)
+    process->cr3 = (uint32_t)page_directory_create();
+    
+    // 사용자 스택과 힙은 영역만 예약하고 프레임은 첫 접근 시 할당
+    process->vm_areas = NULL;
+    process->heap_area = NULL;
+    if (!process->cr3 ||
+        !vm_area_create(&process->vm_areas, USER_STACK_TOP - USER_STACK_SIZE, USER_STACK_SIZE,
+                        PAGE_WRITE | PAGE_USER) ||
+        !(process->heap_area = vm_area_create(&process->vm_areas, USER_HEAP_START, 0,
+                                              PAGE_WRITE | PAGE_USER))) {
+        if (process->cr3) {
+            vm_area_destroy_all(&process->vm_areas, (page_directory_t*)process->cr3);
+            page_directory_destroy((page_directory_t*)process->cr3);
+        }
+        page_free((void*)process->stack_bottom, 0);
+        kmem_cache_free(process_cache, process);
+        return NULL;
+    }
+    
+    __sync_fetch_and_add(&total_processes, 1);
+    return process;
+}
+
+// 프로세스 생성
+process_t* process_create(const char* name, void (*entry_point)(void), priority_t priority) {
+    process_t* process = process_alloc(name, entry_point, priority);
+    if (!process) return NULL;
     
     scheduler_add_process(process);
-    scheduler.total_processes++;
+    return process;
+}
+
+// 커널 스레드 진입점 (트램펄린은 인자 없이 부르므로 본체와 인자는 프로세스 구조체에서)
+static void kthread_entry(void) {
+    process_t* self = process_get_current();
+    self->kthread_fn(self->kthread_data);
+    process_exit();
+}
+
+// 커널 스레드 생성 (인자를 받는 본체, 본체가 돌아오면 종료)
+process_t* kthread_create(const char* name, void (*fn)(void* data), void* data, priority_t priority) {
+    process_t* process = process_alloc(name, kthread_entry, priority);
+    if (!process) return NULL;
     
+    // 다른 CPU가 곧바로 실행할 수 있으므로 준비 큐에 넣기 전에 설정
+    process->kthread_fn = fn;
+    process->kthread_data = data;
+    scheduler_add_process(process);
     return process;
 }
 
+// 프로세스 복제 (사용자 메모리는 쓰기 시 복사로 공유, 사용자 모드의 시스템 콜 안에서만)
+process_t* process_fork(process_t* parent) {
+    if (!parent || !parent->trap_frame) return NULL;
+    
+    process_t* child = (process_t*)kmem_cache_alloc(process_cache);
+    if (!child) return NULL;
+    
+    *child = *parent;
+    child->fpu_state = NULL;            // 부모의 FXSAVE 영역 (실패 경로에서 해제하지 않도록 먼저 지움)
+    child->fpu_cpu = SMP_NO_CPU;
+    child->pid = __sync_fetch_and_add(&next_pid, 1);
+    child->state = PROCESS_READY;
+    child->total_time = 0;
+    child->utime = 0;
+    child->stime = 0;
+    child->on_rq = 0;
+    RB_CLEAR_NODE(&child->run_node);  // 정책과 vruntime은 부모에게서 물려받음
+    
+    // 마감 정책의 대역폭은 승인받은 프로세스만의 것이므로 자식은 공정 정책으로
+    if (child->policy == SCHED_DEADLINE) {
+        child->policy = SCHED_FAIR;
+        child->sched_class = &fair_sched_class;
+        child->vruntime = 0;
+    }
+    child->dl_bw = 0;
+    child->dl_throttled = 0;
+    kernel_timer_init(&child->dl_timer);
+    child->vm_areas = NULL;
+    child->heap_area = NULL;
+    child->next = NULL;
+    child->prev = NULL;
+    child->queue = NULL;
+    child->cpu = smp_cpu_id();
+    child->last_cpu = SMP_NO_CPU;     // 친화성은 부모에게서 물려받음
+    kernel_timer_init(&child->sleep_timer);
+    
+    // 새 커널 스택 (부모 스택의 다른 프레임은 자식 스택에서 유효하지 않으므로 트랩 프레임만 복사)
+    child->stack_bottom = (uint32_t)page_alloc(0);
+    if (!child->stack_bottom) {
+        kmem_cache_free(process_cache, child);
+        return NULL;
+    }
+    child->stack_top = child->stack_bottom + PROCESS_STACK_SIZE;
+    process_init_fork_stack(child, parent);
+    
+    child->cr3 = (uint32_t)page_directory_create();
+    if (!child->cr3 || fpu_fork(child, parent) < 0 ||
+        vm_area_fork(&child->vm_areas, (page_directory_t*)child->cr3,
+                     parent->vm_areas, (page_directory_t*)parent->cr3) < 0) {
+        if (child->cr3) {
+            vm_area_destroy_all(&child->vm_areas, (page_directory_t*)child->cr3);
+            page_directory_destroy((page_directory_t*)child->cr3);
+        }
+        fpu_release(child);
+        page_free((void*)child->stack_bottom, 0);
+        kmem_cache_free(process_cache, child);
+        return NULL;
+    }
+    
+    // 힙 영역은 비어 있을 수 있으므로 시작 주소로 찾기
+    for (vm_area_t* area = child->vm_areas; area && parent->heap_area; area = area->next) {
+        if (area->start == parent->heap_area->start) {
+            child->heap_area = area;
+            break;
+        }
+    }
+    
+    __sync_fetch_and_add(&total_processes, 1);
+    scheduler_add_process(child);
+    
+    return child;
+}
+
+// 현재 프로세스 종료 (자기 커널 스택 위에서 실행 중이므로 해제는 다른 문맥에서)
+void process_exit(void) {
+    disable_interrupts();
+    
+    process_t* process = this_rq()->current_process;
+    if (process) {
+        scheduler_remove_process(process);
+        kernel_timer_cancel_sync(&process->sleep_timer);
+        dl_release_bw(process);
+        process->state = PROCESS_ZOMBIE;
+    }
+    
+    scheduler_schedule();
+    
+    // 좀비 프로세스로는 다시 전환되지 않음
+    while (1) {
+        __asm__ volatile("hlt");
+    }
+}
+
 // 프로세스 제거
 void process_destroy(process_t* process) {
     if (!process) return;
     
+    // 해제 전에 다른 CPU에서 실행 중인 타이머 콜백이 끝나기를 기다림
     scheduler_remove_process(process);
+    kernel_timer_cancel_sync(&process->sleep_timer);
+    dl_release_bw(process);
+    fpu_release(process);
     
     // 메모리 해제
     if (process->stack_bottom) {
-        kfree((void*)process->stack_bottom);
+        page_free((void*)process->stack_bottom, 0);
     }
+    vm_area_destroy_all(&process->vm_areas, (page_directory_t*)process->cr3);
+    process->heap_area = NULL;
     if (process->cr3) {
-        kfree((void*)process->cr3);
+        page_directory_destroy((page_directory_t*)process->cr3);
     }
     
-    kfree(process);
-    scheduler.total_processes--;
+    kmem_cache_free(process_cache, process);
+    __sync_fetch_and_sub(&total_processes, 1);
 }
 
-// 스케줄러에 프로세스 추가
-void scheduler_add_process(process_t* process) {
-    if (!process) return;
-    
-    // 준비 큐에 추가 (우선순위 기반)
-    if (!scheduler.ready_queue) {
-        scheduler.ready_queue = process;
+// 큐 끝에 추가 (원형 이중 연결 리스트)
+static void queue_push_tail(process_t** queue, process_t* process) {
+    if (!*queue) {
+        *queue = process;
         process->next = process;
         process->prev = process;
     } else {
-        // 우선순위에 따라 삽입
-        process_t* current = scheduler.ready_queue;
-        do {
-            if (process->priority > current->priority) {
-                // 현재 위치에 삽입
-                process->next = current;
-                process->prev = current->prev;
-                current->prev->next = process;
-                current->prev = process;
-                
-                if (current == scheduler.ready_queue) {
-                    scheduler.ready_queue = process;
-                }
-                return;
-            }
-            current = current->next;
-        } while (current != scheduler.ready_queue);
-        
-        // 마지막에 추가
-        process->next = scheduler.ready_queue;
-        process->prev = scheduler.ready_queue->prev;
-        scheduler.ready_queue->prev->next = process;
-        scheduler.ready_queue->prev = process;
+        process->next = *queue;
+        process->prev = (*queue)->prev;
+        (*queue)->prev->next = process;
+        (*queue)->prev = process;
     }
+    process->queue = queue;
 }
 
-// 스케줄러에서 프로세스 제거
-void scheduler_remove_process(process_t* process) {
-    if (!process) return;
+// 속한 큐에서 분리
+static void queue_remove(process_t* process) {
+    if (!process->queue) return;
     
-    // 큐에서 제거
+    process_t** queue = process->queue;
     if (process->next == process) {
         // 마지막 프로세스
-        if (scheduler.ready_queue == process) {
-            scheduler.ready_queue = NULL;
-        } else if (scheduler.blocked_queue == process) {
-            scheduler.blocked_queue = NULL;
-        } else if (scheduler.sleeping_queue == process) {
-            scheduler.sleeping_queue = NULL;
-        }
+        *queue = NULL;
     } else {
         process->prev->next = process->next;
         process->next->prev = process->prev;
         
-        if (scheduler.ready_queue == process) {
-            scheduler.ready_queue = process->next;
-        } else if (scheduler.blocked_queue == process) {
-            scheduler.blocked_queue = process->next;
-        } else if (scheduler.sleeping_queue == process) {
-            scheduler.sleeping_queue = process->next;
+        if (*queue == process) {
+            *queue = process->next;
         }
     }
     
     process->next = NULL;
     process->prev = NULL;
+    process->queue = NULL;
 }
 
-// 라운드 로빈 스케줄링
-void scheduler_round_robin(void) {
-    if (!scheduler.ready_queue) return;
+static uint32_t queue_length(process_t* queue) {
+    uint32_t count = 0;
     
-    process_t* next = scheduler.ready_queue->next;
-    scheduler.ready_queue = next;
+    if (queue) {
+        process_t* current = queue;
+        do {
+            count++;
+            current = current->next;
+        } while (current != queue);
+    }
+    return count;
+}
+
+// 틱을 us로 변환 (1초 이상은 1초로, 가중치 곱셈이 32비트를 넘지 않도록)
+static uint32_t ticks_to_us(uint32_t ticks) {
+    if (ticks > timer_frequency) ticks = timer_frequency;
+    return ticks * (1000000 / timer_frequency);
+}
+
+// ---- 마감 클래스 (SCHED_DEADLINE) ----
+// 절대 마감이 가장 이른 프로세스부터 실행 (EDF)
+// 주기마다 runtime만큼의 예산을 주고 다 쓰면 마감 시점까지 멈춤 (CBS), 넘친 프로세스가 다른 프로세스의 몫을 빼앗지 않음
+
+// 절대 마감 비교 (틱 값이 한 바퀴 돌아도 차이의 부호로 판단)
+static int dl_before(uint32_t a, uint32_t b) {
+    return (int32_t)(a - b) < 0;
+}
+
+static process_t* dl_entry(rb_node_t* node) {
+    return node ? rb_entry(node, process_t, run_node) : NULL;
+}
+
+// 준비 트리 삽입 (같은 마감이면 오른쪽으로)
+static void dl_tree_insert(scheduler_t* rq, process_t* process) {
+    rb_node_t** link = &rq->dl_tree.node;
+    rb_node_t* parent = NULL;
     
-    if (scheduler.current_process) {
-        scheduler.current_process->state = PROCESS_READY;
+    while (*link) {
+        parent = *link;
+        if (dl_before(process->dl_abs_deadline, dl_entry(parent)->dl_abs_deadline)) {
+            link = &parent->left;
+        } else {
+            link = &parent->right;
+        }
     }
     
-    next->state = PROCESS_RUNNING;
-    scheduler.current_process = next;
+    rb_link_node(&process->run_node, parent, link);
+    rb_insert_color(&process->run_node, &rq->dl_tree);
+    rq->nr_dl++;
+}
+
+static void dl_tree_remove(scheduler_t* rq, process_t* process) {
+    rb_erase(&process->run_node, &rq->dl_tree);
+    RB_CLEAR_NODE(&process->run_node);
+    rq->nr_dl--;
+}
+
+// 지금부터 새 주기 시작
+static void dl_renew(process_t* process) {
+    process->dl_abs_deadline = timer_ticks + process->dl_deadline;
+    process->dl_budget = process->dl_runtime;
+}
+
+// 남은 예산을 남은 시간 안에 쓰면 승인된 대역폭을 넘는지 (budget / (deadline - now) > runtime / period)
+static int dl_overflow(process_t* process) {
+    uint32_t remaining = process->dl_abs_deadline - timer_ticks;
+    return (uint64_t)(uint32_t)process->dl_budget * process->dl_period >
+           (uint64_t)remaining * process->dl_runtime;
+}
+
+// 예산을 다 쓴 프로세스를 마감 시점까지 멈춤 (준비 트리에서 뺀 뒤 호출)
+// 준비 큐에는 남아 있지만 실행할 수 없으므로 nr_running에서 제외 (유휴 CPU가 hlt하도록)
+static void dl_throttle(scheduler_t* rq, process_t* process) {
+    uint32_t delay = process->dl_abs_deadline - timer_ticks;
+    if ((int32_t)delay < 1) delay = 1;
+    
+    process->dl_throttled = 1;
+    rq->nr_running--;
+    kernel_timer_add(&process->dl_timer, delay, dl_timer_expired, process);
+}
+
+// 예산 보충 (마감을 주기만큼 미루고 runtime을 더함, 그래도 마감이 지났으면 새 주기)
+static void dl_replenish(process_t* process) {
+    while (process->dl_budget <= 0) {
+        process->dl_abs_deadline += process->dl_period;
+        process->dl_budget += process->dl_runtime;
+    }
+    if (!dl_before(timer_ticks, process->dl_abs_deadline)) {
+        dl_renew(process);
+    }
+}
+
+static void dl_enqueue(scheduler_t* rq, process_t* process, uint32_t flags) {
+    // 마감이 지났거나, 깨어났는데 남은 예산을 그대로 쓰면 대역폭을 넘을 때 새 주기 (CBS 깨우기 규칙)
+    if (!dl_before(timer_ticks, process->dl_abs_deadline) ||
+        ((flags & ENQUEUE_WAKEUP) && process->dl_budget > 0 && dl_overflow(process))) {
+        dl_renew(process);
+    }
     
-    // 컨텍스트 스위칭
-    if (scheduler.current_process != next) {
-        context_switch(scheduler.current_process, next);
+    // 예산 없이 잠들었다 깨어나면 마감까지 기다림
+    if (process->dl_budget <= 0) {
+        dl_throttle(rq, process);
+        return;
+    }
+    dl_tree_insert(rq, process);
+}
+
+static void dl_dequeue(scheduler_t* rq, process_t* process) {
+    if (process->dl_throttled) {
+        kernel_timer_cancel(&process->dl_timer);
+        process->dl_throttled = 0;
+        rq->nr_running++;
+        return;
     }
+    dl_tree_remove(rq, process);
+}
+
+// 마감이 가장 이른 프로세스
+static process_t* dl_pick_next(scheduler_t* rq) {
+    return dl_entry(rb_first(&rq->dl_tree));
 }
 
-// 우선순위 스케줄링
-void scheduler_priority(void) {
-    if (!scheduler.ready_queue) return;
+// 실행한 만큼 예산에서 빼고 다 썼으면 멈춤 (실행 중인 프로세스는 다음 재스케줄에서 내려옴)
+static void dl_update_curr(scheduler_t* rq, process_t* current, uint32_t delta) {
+    current->dl_budget -= (int32_t)delta;
+    if (current->dl_budget > 0 || !current->on_rq || current->dl_throttled) return;
     
-    // 가장 높은 우선순위 프로세스 선택
-    process_t* highest = scheduler.ready_queue;
-    process_t* current = scheduler.ready_queue->next;
+    dl_tree_remove(rq, current);
+    dl_throttle(rq, current);
+}
+
+static int dl_tick(scheduler_t* rq, process_t* current) {
+    if (current->dl_throttled) return 1;
+    
+    process_t* first = dl_pick_next(rq);
+    return first && dl_before(first->dl_abs_deadline, current->dl_abs_deadline);
+}
+
+// 이번 주기의 남은 예산을 포기하고 다음 보충까지 대기 (주기 작업이 한 번의 처리를 끝냈을 때)
+static void dl_yield(scheduler_t* rq, process_t* current) {
+    if (current->dl_throttled) return;
     
-    while (current != scheduler.ready_queue) {
-        if (current->priority > highest->priority) {
-            highest = current;
+    current->dl_budget = 0;
+    dl_tree_remove(rq, current);
+    dl_throttle(rq, current);
+}
+
+static int dl_wakeup_preempt(scheduler_t* rq, process_t* current, process_t* process) {
+    (void)rq;
+    return current->dl_throttled || dl_before(process->dl_abs_deadline, current->dl_abs_deadline);
+}
+
+// 마감이 이른 쪽부터, 실행 중이지 않고 cpu에서 실행할 수 있는 첫 프로세스 (절대 마감은 모든 CPU에 공통)
+static process_t* dl_steal(scheduler_t* rq, uint32_t cpu) {
+    for (rb_node_t* node = rb_first(&rq->dl_tree); node; node = rb_next(node)) {
+        process_t* process = dl_entry(node);
+        if (process != rq->current_process && (process->affinity & (1u << cpu))) {
+            return process;
         }
-        current = current->next;
     }
+    return NULL;
+}
+
+const sched_class_t deadline_sched_class = {
+    .name = "deadline",
+    .enqueue = dl_enqueue,
+    .dequeue = dl_dequeue,
+    .pick_next = dl_pick_next,
+    .tick = dl_tick,
+    .yield = dl_yield,
+    .wakeup_preempt = dl_wakeup_preempt,
+    .update_curr = dl_update_curr,
+    .steal = dl_steal,
+    .migrate_from = NULL,
+    .migrate_to = NULL,
+};
+
+// ---- 우선순위 큐 클래스 (SCHED_ROUND_ROBIN, SCHED_PRIORITY) ----
+
+// 비어 있지 않은 가장 높은 우선순위 (run_bitmap이 0이 아닐 때만 호출)
+static uint32_t highest_priority(scheduler_t* rq) {
+    return 31 - __builtin_clz(rq->run_bitmap);
+}
+
+static void prio_enqueue(scheduler_t* rq, process_t* process, uint32_t flags) {
+    (void)flags;
+    queue_push_tail(&rq->run_queue[process->priority], process);
+    rq->run_bitmap |= 1u << process->priority;
+}
+
+static void prio_dequeue(scheduler_t* rq, process_t* process) {
+    queue_remove(process);
     
-    if (scheduler.current_process != highest) {
-        if (scheduler.current_process) {
-            scheduler.current_process->state = PROCESS_READY;
-        }
-        
-        highest->state = PROCESS_RUNNING;
-        scheduler.current_process = highest;
-        
-        context_switch(scheduler.current_process, highest);
+    // 비게 된 준비 큐는 비트맵에서 제거
+    if (!rq->run_queue[process->priority]) {
+        rq->run_bitmap &= ~(1u << process->priority);
     }
 }
 
-// 멀티레벨 피드백 큐 스케줄링
-void scheduler_multilevel_feedback(void) {
-    // 간단한 구현: 우선순위 기반 + 시간 슬라이스 조정
-    if (!scheduler.ready_queue) return;
+// 가장 높은 우선순위 큐의 맨 앞 (선점된 프로세스는 맨 앞에 남아 있으므로 이어서 실행)
+static process_t* prio_pick_next(scheduler_t* rq) {
+    return rq->run_bitmap ? rq->run_queue[highest_priority(rq)] : NULL;
+}
+
+// 같은 우선순위 큐 맨 뒤로
+static void prio_yield(scheduler_t* rq, process_t* current) {
+    prio_dequeue(rq, current);
+    prio_enqueue(rq, current, 0);
+}
+
+static int prio_tick(scheduler_t* rq, process_t* current) {
+    // 더 높은 우선순위 큐에 프로세스가 있으면 바로
+    if (highest_priority(rq) > current->priority) return 1;
     
-    process_t* current = scheduler.ready_queue;
+    // 라운드 로빈은 같은 큐에 다른 프로세스가 있고 시간 양자를 다 썼을 때 맨 뒤로
+    if (current->policy != SCHED_ROUND_ROBIN || current->next == current) return 0;
+    if (timer_ticks - current->slice_start < rq->time_quantum) return 0;
     
-    // 시간 슬라이스가 남아있으면 계속 실행
-    if (current->time_slice > 0) {
-        current->time_slice--;
-        return;
+    prio_yield(rq, current);
+    return 1;
+}
+
+static int prio_wakeup_preempt(scheduler_t* rq, process_t* current, process_t* process) {
+    (void)rq;
+    return process->priority > current->priority;
+}
+
+// 높은 우선순위부터, 실행 중이지 않고 cpu에서 실행할 수 있는 첫 프로세스
+static process_t* prio_steal(scheduler_t* rq, uint32_t cpu) {
+    for (uint32_t level = PRIORITY_LEVELS; level-- > 0; ) {
+        process_t* head = rq->run_queue[level];
+        process_t* process = head;
+        
+        while (process) {
+            if (process != rq->current_process && (process->affinity & (1u << cpu))) {
+                return process;
+            }
+            process = process->next;
+            if (process == head) break;
+        }
     }
+    return NULL;
+}
+
+const sched_class_t priority_sched_class = {
+    .name = "priority",
+    .enqueue = prio_enqueue,
+    .dequeue = prio_dequeue,
+    .pick_next = prio_pick_next,
+    .tick = prio_tick,
+    .yield = prio_yield,
+    .wakeup_preempt = prio_wakeup_preempt,
+    .update_curr = NULL,
+    .steal = prio_steal,
+    .migrate_from = NULL,
+    .migrate_to = NULL,
+};
+
+// ---- 공정 클래스 (SCHED_FAIR) ----
+
+// vruntime 비교 (값이 한 바퀴 돌아도 차이의 부호로 판단)
+static int64_t vruntime_delta(uint64_t a, uint64_t b) {
+    return (int64_t)(a - b);
+}
+
+static process_t* fair_entry(rb_node_t* node) {
+    return node ? rb_entry(node, process_t, run_node) : NULL;
+}
+
+// 준비 트리 삽입 (같은 vruntime이면 오른쪽으로, 먼저 들어온 프로세스가 먼저 실행)
+static void fair_tree_insert(scheduler_t* rq, process_t* process) {
+    rb_node_t** link = &rq->fair_tree.node;
+    rb_node_t* parent = NULL;
     
-    // 시간 슬라이스 소진: 우선순위 낮추고 다음 프로세스로
-    if (current->priority > PRIORITY_LOW) {
-        current->priority--;
+    while (*link) {
+        parent = *link;
+        if (vruntime_delta(process->vruntime, fair_entry(parent)->vruntime) < 0) {
+            link = &parent->left;
+        } else {
+            link = &parent->right;
+        }
     }
-    current->time_slice = scheduler.time_quantum;
     
-    scheduler_round_robin();
+    rb_link_node(&process->run_node, parent, link);
+    rb_insert_color(&process->run_node, &rq->fair_tree);
 }
 
-// 스케줄러 실행
-void scheduler_schedule(void) {
-    if (!scheduler.ready_queue) return;
+// 가장 작은 vruntime을 따라 min_vruntime 전진 (뒤로는 가지 않음)
+static void update_min_vruntime(scheduler_t* rq) {
+    process_t* leftmost = fair_entry(rb_first(&rq->fair_tree));
     
-    // 현재 스케줄링 알고리즘 선택
-    scheduler_multilevel_feedback();
+    if (leftmost && vruntime_delta(leftmost->vruntime, rq->min_vruntime) > 0) {
+        rq->min_vruntime = leftmost->vruntime;
+    }
 }
 
-// 프로세스 양보
-void scheduler_yield(void) {
-    if (scheduler.current_process) {
-        scheduler.current_process->state = PROCESS_READY;
-        scheduler_schedule();
+// 이번 주기의 프로세스 몫 (목표 주기를 가중치 비율로 나눔, 프로세스가 많으면 주기를 늘림)
+static uint32_t fair_slice(scheduler_t* rq, process_t* process) {
+    uint32_t period = FAIR_LATENCY;
+    if (rq->nr_fair * FAIR_MIN_GRANULARITY > period) {
+        period = rq->nr_fair * FAIR_MIN_GRANULARITY;
     }
+    
+    uint32_t weight = fair_weights[process->priority];
+    uint32_t load = rq->fair_load > weight ? rq->fair_load : weight;
+    
+    // 16us 단위로 계산해 곱셈이 32비트를 넘지 않도록
+    uint32_t slice = (period / 16) * weight / load * 16;
+    return slice > FAIR_MIN_GRANULARITY ? slice : FAIR_MIN_GRANULARITY;
 }
 
-// 프로세스 블록
-void process_block(process_t* process) {
-    if (!process) return;
+// 깨어나는 공정 프로세스의 vruntime 조정 (오래 잠들었어도 목표 주기의 절반만큼만 앞서도록)
+static void fair_place(scheduler_t* rq, process_t* process) {
+    uint64_t floor = rq->min_vruntime - FAIR_LATENCY / 2;
     
-    scheduler_remove_process(process);
-    process->state = PROCESS_BLOCKED;
-    
-    // 블록된 큐에 추가
-    if (!scheduler.blocked_queue) {
-        scheduler.blocked_queue = process;
-        process->next = process;
-        process->prev = process;
-    } else {
-        process->next = scheduler.blocked_queue;
-        process->prev = scheduler.blocked_queue->prev;
-        scheduler.blocked_queue->prev->next = process;
-        scheduler.blocked_queue->prev = process;
+    if (vruntime_delta(process->vruntime, floor) < 0) {
+        process->vruntime = floor;
     }
 }
 
-// 프로세스 언블록
-void process_unblock(process_t* process) {
-    if (!process || process->state != PROCESS_BLOCKED) return;
-    
-    scheduler_remove_process(process);
-    process->state = PROCESS_READY;
-    scheduler_add_process(process);
+static void fair_enqueue(scheduler_t* rq, process_t* process, uint32_t flags) {
+    if (flags & ENQUEUE_WAKEUP) {
+        fair_place(rq, process);
+    }
+    fair_tree_insert(rq, process);
+    rq->nr_fair++;
+    rq->fair_load += fair_weights[process->priority];
 }
 
-// 현재 프로세스 가져오기
-process_t* process_get_current(void) {
-    return scheduler.current_process;
+static void fair_dequeue(scheduler_t* rq, process_t* process) {
+    rb_erase(&process->run_node, &rq->fair_tree);
+    RB_CLEAR_NODE(&process->run_node);
+    rq->nr_fair--;
+    rq->fair_load -= fair_weights[process->priority];
+    update_min_vruntime(rq);
 }
 
-// 현재 PID 가져오기
-uint32_t process_get_pid(void) {
-    return scheduler.current_process ? scheduler.current_process->pid : 0;
+// vruntime이 가장 작은 프로세스
+static process_t* fair_pick_next(scheduler_t* rq) {
+    return fair_entry(rb_first(&rq->fair_tree));
 }
 
-// 타이머 초기화
-void timer_init(uint32_t frequency) {
-    timer_frequency = frequency;
-    
-    // PIT (Programmable Interval Timer) 설정
-    uint32_t divisor = 1193180 / frequency;
+// 실행 시간을 가중치로 나눠 vruntime에 더함 (NORMAL은 실제 시간 그대로, 트리 안의 위치가 바뀌므로 다시 삽입)
+static void fair_update_curr(scheduler_t* rq, process_t* current, uint32_t delta) {
+    if (current->on_rq) {
+        rb_erase(&current->run_node, &rq->fair_tree);
+    }
+    current->vruntime += ticks_to_us(delta) * FAIR_WEIGHT_NORMAL / fair_weights[current->priority];
+    if (current->on_rq) {
+        fair_tree_insert(rq, current);
+        update_min_vruntime(rq);
+    }
+}
+
+// 몫을 다 썼거나, 최소 실행 시간이 지났고 가장 뒤처진 프로세스와의 차이가 몫보다 클 때
+static int fair_tick(scheduler_t* rq, process_t* current) {
+    if (rq->nr_fair < 2) return 0;
     
-    // PIT 명령 바이트
-    __asm__ volatile("outb %0, %1" : : "a" (0x36), "Nd" (0x43));
-    __asm__ volatile("outb %0, %1" : : "a" (divisor & 0xFF), "Nd" (0x40));
-    __asm__ volatile("outb %0, %1" : : "a" ((divisor >> 8) & 0xFF), "Nd" (0x40));
+    uint32_t ran = ticks_to_us(timer_ticks - current->slice_start);
+    uint32_t slice = fair_slice(rq, current);
+    if (ran >= slice) return 1;
+    if (ran < FAIR_MIN_GRANULARITY) return 0;
     
-    // 타이머 인터럽트 핸들러 등록
-    irq_install_handler(0, timer_handler);
-    pic_unmask_irq(0);
+    process_t* leftmost = fair_pick_next(rq);
+    return vruntime_delta(current->vruntime, leftmost->vruntime) > (int64_t)slice;
 }
 
-// 타이머 핸들러
-void timer_handler(void) {
-    timer_ticks++;
-    
-    // 스케줄러 호출 (매 10틱마다)
-    if (timer_ticks % 10 == 0) {
-        scheduler_schedule();
-    }
+// 준비 트리의 맨 뒤로 (다른 모든 공정 프로세스가 먼저 실행)
+static void fair_yield(scheduler_t* rq, process_t* current) {
+    process_t* last = fair_entry(rb_last(&rq->fair_tree));
+    if (!last || last == current || vruntime_delta(last->vruntime, current->vruntime) <= 0) return;
     
-    // 슬립 큐 처리
-    process_t* current = scheduler.sleeping_queue;
-    while (current) {
-        process_t* next = current->next;
-        
-        if (current->time_slice <= timer_ticks) {
-            scheduler_remove_process(current);
-            current->state = PROCESS_READY;
-            scheduler_add_process(current);
+    rb_erase(&current->run_node, &rq->fair_tree);
+    current->vruntime = last->vruntime;
+    fair_tree_insert(rq, current);
+    update_min_vruntime(rq);
+}
+
+// 깨어난 프로세스의 vruntime이 충분히 앞설 때만 선점 (짧은 간격으로 서로 선점하지 않도록)
+static int fair_wakeup_preempt(scheduler_t* rq, process_t* current, process_t* process) {
+    (void)rq;
+    return vruntime_delta(current->vruntime, process->vruntime) > FAIR_WAKEUP_GRANULARITY;
+}
+
+// vruntime이 작은 쪽부터, 실행 중이지 않고 cpu에서 실행할 수 있는 첫 프로세스
+static process_t* fair_steal(scheduler_t* rq, uint32_t cpu) {
+    for (rb_node_t* node = rb_first(&rq->fair_tree); node; node = rb_next(node)) {
+        process_t* process = fair_entry(node);
+        if (process != rq->current_process && (process->affinity & (1u << cpu))) {
+            return process;
         }
-        
-        current = next;
-        if (current == scheduler.sleeping_queue) break;
     }
+    return NULL;
 }
 
-// 현재 틱 수 가져오기
-uint32_t timer_get_ticks(void) {
-    return timer_ticks;
+// CPU 간 이동은 각 CPU의 min_vruntime과의 차이를 유지
+static void fair_migrate_from(scheduler_t* rq, process_t* process) {
+    process->vruntime -= rq->min_vruntime;
 }
 
-// 타이머 슬립
-void timer_sleep(uint32_t ticks) {
-    uint32_t wake_time = timer_ticks + ticks;
-    
-    if (scheduler.current_process) {
-        scheduler.current_process->time_slice = wake_time;
-        scheduler.current_process->state = PROCESS_SLEEPING;
-        
-        scheduler_remove_process(scheduler.current_process);
-        
-        // 슬립 큐에 추가
-        if (!scheduler.sleeping_queue) {
-            scheduler.sleeping_queue = scheduler.current_process;
-            scheduler.current_process->next = scheduler.current_process;
-            scheduler.current_process->prev = scheduler.current_process;
-        } else {
-            scheduler.current_process->next = scheduler.sleeping_queue;
-            scheduler.current_process->prev = scheduler.sleeping_queue->prev;
-            scheduler.sleeping_queue->prev->next = scheduler.current_process;
-            scheduler.sleeping_queue->prev = scheduler.current_process;
-        }
-        
-        scheduler_schedule();
+static void fair_migrate_to(scheduler_t* rq, process_t* process) {
+    process->vruntime += rq->min_vruntime;
+}
+
+const sched_class_t fair_sched_class = {
+    .name = "fair",
+    .enqueue = fair_enqueue,
+    .dequeue = fair_dequeue,
+    .pick_next = fair_pick_next,
+    .tick = fair_tick,
+    .yield = fair_yield,
+    .wakeup_preempt = fair_wakeup_preempt,
+    .update_curr = fair_update_curr,
+    .steal = fair_steal,
+    .migrate_from = fair_migrate_from,
+    .migrate_to = fair_migrate_to,
+};
+
+// ---- 클래스 공통 ----
+
+// 선택 순서 (앞선 클래스가 항상 먼저)
+static const sched_class_t* const sched_classes[] = {
+    &deadline_sched_class,
+    &priority_sched_class,
+    &fair_sched_class,
+};
+
+#define SCHED_CLASS_COUNT (sizeof(sched_classes) / sizeof(sched_classes[0]))
+
+// 선택 순서상 위치 (작을수록 먼저)
+static uint32_t class_rank(const sched_class_t* class) {
+    uint32_t rank = 0;
+    while (rank < SCHED_CLASS_COUNT && sched_classes[rank] != class) {
+        rank++;
     }
+    return rank;
 }
 
-// 컨텍스트 스위칭 (어셈블리에서 구현)
-void context_switch(process_t* from, process_t* to) {
-    if (from) {
-        save_context(from);
+// 준비 큐에 추가 (rq 잠금을 잡은 상태에서 호출)
+static void enqueue_process(scheduler_t* rq, process_t* process, uint32_t flags) {
+    process->sched_class->enqueue(rq, process, flags);
+    process->on_rq = 1;
+    rq->nr_running++;
+}
+
+// 속한 큐에서 분리 (준비 큐는 클래스가, 블록/슬립 큐는 직접, rq 잠금을 잡은 상태에서 호출)
+static void dequeue_process(scheduler_t* rq, process_t* process) {
+    if (process->on_rq) {
+        process->sched_class->dequeue(rq, process);
+        process->on_rq = 0;
+        rq->nr_running--;
+        return;
     }
+    queue_remove(process);
+}
+
+// 현재 프로세스의 실행 시간 반영 (rq 잠금을 잡은 상태에서 호출)
+static void update_current(scheduler_t* rq) {
+    process_t* current = rq->current_process;
+    if (!current) return;
     
-    if (to) {
-        restore_context(to);
+    uint32_t delta = timer_ticks - current->exec_start;
+    if (!delta) return;
+    
+    current->exec_start = timer_ticks;
+    current->total_time += delta;
+    if (current->sched_class->update_curr) {
+        current->sched_class->update_curr(rq, current, delta);
     }
 }
 
-// 컨텍스트 저장 (어셈블리에서 구현)
-void save_context(process_t* process) {
-    // 실제 구현은 어셈블리에서
-    (void)process;
+// 다음에 실행할 프로세스 (앞선 클래스부터)
+static process_t* pick_next_process(scheduler_t* rq) {
+    for (uint32_t i = 0; i < SCHED_CLASS_COUNT; i++) {
+        process_t* next = sched_classes[i]->pick_next(rq);
+        if (next) return next;
+    }
+    return NULL;
 }
 
-// 컨텍스트 복원 (어셈블리에서 구현)
-void restore_context(process_t* process) {
-    // 실제 구현은 어셈블리에서
-    (void)process;
+// 현재 프로세스보다 앞선 클래스에 준비된 프로세스가 있는지
+static int higher_class_ready(scheduler_t* rq, process_t* current) {
+    uint32_t rank = class_rank(current->sched_class);
+    for (uint32_t i = 0; i < rank; i++) {
+        if (sched_classes[i]->pick_next(rq)) return 1;
+    }
+    return 0;
 }
 
-// 스케줄러 통계 출력
-void scheduler_dump_stats(void) {
-    // 간단한 통계 출력
-    uint32_t total = scheduler.total_processes;
-    uint32_t ready = 0;
-    uint32_t blocked = 0;
-    uint32_t sleeping = 0;
+// 준비 상태가 된 프로세스를 넣을 CPU
+// 직전 CPU가 허용되면 캐시를 위해 유지하고, 더 한가한 CPU가 있으면 그쪽으로
+static uint32_t select_cpu(process_t* process) {
+    uint32_t allowed = process->affinity & smp_online_mask();
+    uint32_t best = process->cpu;
     
-    // 준비 큐 카운트
-    if (scheduler.ready_queue) {
-        process_t* current = scheduler.ready_queue;
-        do {
-            ready++;
-            current = current->next;
-        } while (current != scheduler.ready_queue);
+    if (!allowed) return best;
+    if (!(allowed & (1u << best))) {
+        best = __builtin_ctz(allowed);
     }
     
-    // 블록된 큐 카운트
-    if (scheduler.blocked_queue) {
-        process_t* current = scheduler.blocked_queue;
-        do {
-            blocked++;
-            current = current->next;
-        } while (current != scheduler.blocked_queue);
+    uint32_t best_load = smp_get_cpu(best)->sched.nr_running;
+    for (uint32_t i = 0; i < smp_cpu_count() && best_load; i++) {
+        uint32_t load = smp_get_cpu(i)->sched.nr_running;
+        if ((allowed & (1u << i)) && load < best_load) {
+            best = i;
+            best_load = load;
+        }
     }
+    return best;
+}
+
+// 준비 큐에 들어온 프로세스가 현재 프로세스를 선점해야 하는지 (rq 잠금을 잡은 상태에서 호출)
+// 앞선 클래스는 항상, 같은 클래스면 클래스가 판단
+static int wakeup_preempt(scheduler_t* rq, process_t* process) {
+    process_t* current = rq->current_process;
     
-    // 슬립 큐 카운트
-    if (scheduler.sleeping_queue) {
-        process_t* current = scheduler.sleeping_queue;
-        do {
-            sleeping++;
-            current = current->next;
-        } while (current != scheduler.sleeping_queue);
+    if (!current) return 1;
+    if (current == process || current->state != PROCESS_RUNNING) return 0;
+    
+    uint32_t rank = class_rank(process->sched_class);
+    uint32_t current_rank = class_rank(current->sched_class);
+    if (rank != current_rank) return rank < current_rank;
+    
+    update_current(rq);
+    return process->sched_class->wakeup_preempt(rq, current, process);
+}
+
+// 준비 상태가 된 프로세스를 준비 큐에 넣음 (process가 속한 rq의 잠금을 잡은 상태에서 호출, 잠금은 여기서 해제)
+static void ready_process(scheduler_t* rq, process_t* process, uint32_t flags) {
+    uint32_t target = process->cpu;
+    
+    // 잠들기 직전에 깨어나 아직 자기 CPU에서 전환 중이면 스택을 쓰고 있으므로 그 CPU에 그대로
+    if (rq->current_process != process) {
+        target = select_cpu(process);
+    }
+    
+    if (target != process->cpu) {
+        // 잠금을 놓기 전에 CPU를 바꿔 두면 이후 process_rq_lock은 새 CPU의 잠금을 기다림
+        if (process->sched_class->migrate_from) {
+            process->sched_class->migrate_from(rq, process);
+        }
+        process->cpu = target;
+        spin_unlock(&rq->lock);
+        
+        rq = &smp_get_cpu(target)->sched;
+        spin_lock(&rq->lock);
+        if (process->sched_class->migrate_to) {
+            process->sched_class->migrate_to(rq, process);
+        }
+    }
+    
+    enqueue_process(rq, process, ENQUEUE_WAKEUP);
+    int preempt = wakeup_preempt(rq, process);
+    spin_unlock_irqrestore(&rq->lock, flags);
+    
+    // 유휴 중이거나 선점해야 하는 CPU는 바로 깨워서 전환
+    if (preempt) {
+        smp_send_reschedule(smp_get_cpu(target));
+    }
+}
+
+// 스케줄러에 프로세스 추가 (정책의 준비 큐에)
+void scheduler_add_process(process_t* process) {
+    if (!process) return;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    ready_process(rq, process, flags);
+}
+
+// 스케줄러에서 프로세스 제거 (속한 큐에서 분리)
+void scheduler_remove_process(process_t* process) {
+    if (!process) return;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    dequeue_process(rq, process);
+    spin_unlock_irqrestore(&rq->lock, flags);
+}
+
+// 정책과 우선순위 변경 (준비 상태면 새 큐 끝으로 이동, rq 잠금을 잡은 상태에서 호출)
+static void set_sched_locked(scheduler_t* rq, process_t* process, sched_policy_t policy, priority_t priority) {
+    int queued = process->on_rq;
+    if (queued) {
+        // 실행 중이면 지금까지의 실행 시간은 이전 클래스와 가중치로 반영
+        if (rq->current_process == process) {
+            update_current(rq);
+        }
+        dequeue_process(rq, process);
+    }
+    
+    // 마감 정책을 떠나면 대역폭 반납
+    if (policy != SCHED_DEADLINE && process->dl_bw) {
+        dl_return_bw(process);
+    }
+    
+    // 다른 클래스에서 공정 정책으로 오면 오래된 vruntime을 현재 기준으로 재배치
+    uint32_t enqueue_flags = policy_class(policy) != process->sched_class ? ENQUEUE_WAKEUP : 0;
+    process->policy = policy;
+    process->sched_class = policy_class(policy);
+    process->priority = priority;
+    if (queued) {
+        enqueue_process(rq, process, enqueue_flags);
+        if (rq->current_process != process && wakeup_preempt(rq, process)) {
+            rq->need_resched = 1;
+        }
+    }
+}
+
+void scheduler_set_priority(process_t* process, priority_t priority) {
+    if (!process || (uint32_t)priority >= PRIORITY_LEVELS) return;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    set_sched_locked(rq, process, process->policy, priority);
+    spin_unlock_irqrestore(&rq->lock, flags);
+}
+
+// 스케줄링 정책 변경 (우선순위는 공정 정책에서 가중치, 우선순위 큐 정책에서 큐 번호, 마감 정책은 scheduler_set_deadline으로)
+void scheduler_set_policy(process_t* process, sched_policy_t policy) {
+    if (!process || (uint32_t)policy > SCHED_PRIORITY) return;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    set_sched_locked(rq, process, policy, process->priority);
+    spin_unlock_irqrestore(&rq->lock, flags);
+}
+
+// 마감 정책 설정 (runtime, deadline, period는 틱, runtime <= deadline <= period)
+// 승인 검사: 프로세스 하나의 대역폭은 한 CPU의 95%, 전체 합은 CPU 수 × 95%를 넘을 수 없음 (넘으면 -1)
+int scheduler_set_deadline(process_t* process, uint32_t runtime, uint32_t deadline, uint32_t period) {
+    if (!process || !runtime || runtime > deadline || deadline > period || period > DL_PERIOD_MAX) return -1;
+    
+    uint32_t bw = (runtime << DL_BW_SHIFT) / period;
+    if (bw > DL_BW_LIMIT) return -1;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    
+    // 이미 마감 정책이면 기존 대역폭을 새 대역폭으로 바꿔서 검사
+    spin_lock(&dl_bw_lock);
+    uint32_t total = dl_total_bw - process->dl_bw + bw;
+    int admitted = total <= smp_cpu_count() * DL_BW_LIMIT;
+    if (admitted) {
+        dl_total_bw = total;
+        process->dl_bw = bw;
+    }
+    spin_unlock(&dl_bw_lock);
+    
+    if (!admitted) {
+        spin_unlock_irqrestore(&rq->lock, flags);
+        return -1;
+    }
+    
+    // 준비 큐에 있으면 빼고 매개변수를 바꾼 뒤 다시 넣음 (새로 마감 정책이 되면 바로 새 주기)
+    if (process->policy != SCHED_DEADLINE) {
+        process->dl_abs_deadline = timer_ticks;
+        process->dl_budget = 0;
+    }
+    process->dl_runtime = runtime;
+    process->dl_deadline = deadline;
+    process->dl_period = period;
+    if (process->dl_budget > (int32_t)runtime) {
+        process->dl_budget = runtime;
+    }
+    set_sched_locked(rq, process, SCHED_DEADLINE, process->priority);
+    
+    spin_unlock_irqrestore(&rq->lock, flags);
+    return 0;
+}
+
+// 이후 생성되는 프로세스의 정책 (fork는 부모의 정책을 물려받음)
+void scheduler_set_default_policy(sched_policy_t policy) {
+    if ((uint32_t)policy > SCHED_PRIORITY) return;
+    default_policy = policy;
+}
+
+// 친화성이 허용하지 않는 CPU의 준비 큐에 있는 프로세스를 허용된 CPU로 옮김
+static void process_migrate(process_t* process) {
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    
+    if (rq->current_process == process || !process->on_rq ||
+        (process->affinity & (1u << process->cpu))) {
+        spin_unlock_irqrestore(&rq->lock, flags);
+        return;
+    }
+    
+    dequeue_process(rq, process);
+    ready_process(rq, process, flags);
+}
+
+// CPU 친화성 설정 (실행 중이면 다음 전환 때 허용된 CPU로 옮겨짐)
+int scheduler_set_affinity(process_t* process, uint32_t mask) {
+    if (!process || !(mask & smp_online_mask())) return -1;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    process->affinity = mask;
+    int running = rq->current_process == process;
+    spin_unlock_irqrestore(&rq->lock, flags);
+    
+    if (mask & (1u << process->cpu)) return 0;
+    
+    if (running) {
+        smp_send_reschedule(smp_get_cpu(process->cpu));
+    } else {
+        process_migrate(process);
+    }
+    return 0;
+}
+
+// 다음 프로세스로 전환 (rq 잠금을 잡은 상태에서 호출)
+static void scheduler_switch_to(scheduler_t* rq, process_t* next) {
+    process_t* prev = rq->current_process;
+    
+    if (prev && prev != next && prev->state == PROCESS_RUNNING) {
+        prev->state = PROCESS_READY;
+    }
+    next->state = PROCESS_RUNNING;
+    if (prev == next) return;
+    
+    // 새 실행 구간 시작 (시간 양자와 공정 정책 몫은 여기부터 계산)
+    next->slice_start = timer_ticks;
+    next->exec_start = timer_ticks;
+    
+    rq->current_process = next;
+    context_switch(prev, next);
+}
+
+// 두 CPU의 스케줄러 잠금 (교착을 피하도록 항상 낮은 번호부터)
+static void double_lock(scheduler_t* a, scheduler_t* b) {
+    if (a < b) {
+        spin_lock(&a->lock);
+        spin_lock(&b->lock);
+    } else {
+        spin_lock(&b->lock);
+        spin_lock(&a->lock);
+    }
+}
+
+// 준비 큐가 빈 CPU가 가장 많이 밀린 CPU에서 프로세스 하나를 가져옴 (인터럽트를 끈 상태에서 호출)
+static void steal_process(scheduler_t* rq) {
+    uint32_t this_id = smp_cpu_id();
+    scheduler_t* busiest = NULL;
+    uint32_t max_load = 1; // 실행 중인 프로세스 하나뿐인 CPU에서는 가져오지 않음
+    
+    for (uint32_t i = 0; i < smp_cpu_count(); i++) {
+        scheduler_t* other = &smp_get_cpu(i)->sched;
+        if (i != this_id && other->nr_running > max_load) {
+            busiest = other;
+            max_load = other->nr_running;
+        }
+    }
+    if (!busiest) return;
+    
+    double_lock(rq, busiest);
+    
+    // 앞선 클래스부터 (실행 중인 프로세스는 그 CPU가 스택을 쓰고 있으므로 제외)
+    process_t* victim = NULL;
+    for (uint32_t i = 0; i < SCHED_CLASS_COUNT && !victim; i++) {
+        victim = sched_classes[i]->steal(busiest, this_id);
+    }
+    
+    if (victim) {
+        dequeue_process(busiest, victim);
+        if (victim->sched_class->migrate_from) {
+            victim->sched_class->migrate_from(busiest, victim);
+        }
+        victim->cpu = this_id;
+        if (victim->sched_class->migrate_to) {
+            victim->sched_class->migrate_to(rq, victim);
+        }
+        enqueue_process(rq, victim, 0);
+    }
+    
+    spin_unlock(&busiest->lock);
+    spin_unlock(&rq->lock);
+}
+
+// 스케줄러 실행
+void scheduler_schedule(void) {
+    uint32_t flags = irq_save();
+    scheduler_t* rq = this_rq();
+    
+    // 준비 큐가 비었으면 다른 CPU에서 가져옴
+    if (!rq->nr_running && smp_cpu_count() > 1) {
+        steal_process(rq);
+    }
+    
+    spin_lock(&rq->lock);
+    rq->need_resched = 0;
+    update_current(rq);
+    
+    // 친화성이 바뀌어 이 CPU에서 실행할 수 없게 된 프로세스는 전환 후 옮김
+    process_t* current = rq->current_process;
+    if (current && current->state == PROCESS_RUNNING && !(current->affinity & (1u << smp_cpu_id()))) {
+        dequeue_process(rq, current);
+        current->state = PROCESS_READY;
+        rq->migrate_process = current;
+    }
+    
+    // 종료한 프로세스는 자기 스택을 벗어난 뒤에 회수 목록으로
+    if (current && current->state == PROCESS_ZOMBIE) {
+        rq->dead_process = current;
+    }
+    
+    process_t* next = pick_next_process(rq);
+    if (next) {
+        scheduler_switch_to(rq, next);
+    } else {
+        // 실행할 프로세스가 없으면 유휴 문맥으로 (current_process == NULL)
+        process_t* prev = rq->current_process;
+        if (prev) {
+            rq->current_process = NULL;
+            context_switch(prev, NULL);
+        }
+    }
+    
+    scheduler_finish_switch();
+    irq_restore(flags);
+}
+
+// 전환 마무리 (전환되어 온 문맥에서 호출, 다른 CPU에서 잠든 문맥일 수 있으므로 현재 CPU를 다시 조회)
+void scheduler_finish_switch(void) {
+    scheduler_t* rq = this_rq();
+    process_t* migrate = rq->migrate_process;
+    process_t* dead = rq->dead_process;
+    
+    rq->migrate_process = NULL;
+    rq->dead_process = NULL;
+    spin_unlock(&rq->lock);
+    
+    // 준비 큐에서 빠진 상태이므로 다른 경로가 건드리지 않음 (깨우기와 process_migrate는 무시)
+    if (migrate) {
+        uint32_t flags;
+        scheduler_t* old_rq = process_rq_lock(migrate, &flags);
+        ready_process(old_rq, migrate, flags);
+    }
+    
+    if (dead) {
+        uint32_t flags = spin_lock_irqsave(&zombie_wait.lock);
+        queue_push_tail(&zombie_queue, dead);
+        wake_up_locked(&zombie_wait, NULL, 1);
+        spin_unlock_irqrestore(&zombie_wait.lock, flags);
+    }
+}
+
+// 회수할 좀비 프로세스를 기다려 꺼냄 (스택을 벗어난 뒤이므로 process_destroy로 해제 가능)
+process_t* process_reap(void) {
+    uint32_t flags = spin_lock_irqsave(&zombie_wait.lock);
+    while (!zombie_queue) {
+        wait_queue_sleep_locked(&zombie_wait, NULL, WAIT_EXCLUSIVE, 0);
+    }
+    
+    process_t* zombie = zombie_queue;
+    queue_remove(zombie);
+    spin_unlock_irqrestore(&zombie_wait.lock, flags);
+    return zombie;
+}
+
+// 인터럽트 종료 시 재스케줄 (인터럽트 핸들러 안에서는 need_resched만 설정)
+void scheduler_irq_exit(void) {
+    if (this_rq()->need_resched) {
+        scheduler_schedule();
+    }
+}
+
+// 프로세스 양보 (같은 클래스의 다른 프로세스가 먼저 실행되도록 클래스가 위치를 옮김)
+void scheduler_yield(void) {
+    uint32_t flags = irq_save();
+    scheduler_t* rq = this_rq();
+    process_t* current = rq->current_process;
+    
+    if (current) {
+        spin_lock(&rq->lock);
+        update_current(rq);
+        if (current->on_rq) {
+            current->sched_class->yield(rq, current);
+        }
+        spin_unlock(&rq->lock);
+        scheduler_schedule();
+    }
+    irq_restore(flags);
+}
+
+// 프로세스 블록
+void process_block(process_t* process) {
+    if (!process) return;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    dequeue_process(rq, process);
+    process->state = PROCESS_BLOCKED;
+    
+    // 블록된 큐에 추가
+    queue_push_tail(&rq->blocked_queue, process);
+    spin_unlock_irqrestore(&rq->lock, flags);
+}
+
+// 프로세스 언블록
+void process_unblock(process_t* process) {
+    if (!process) return;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    if (process->state != PROCESS_BLOCKED) {
+        spin_unlock_irqrestore(&rq->lock, flags);
+        return;
+    }
+    
+    dequeue_process(rq, process);
+    process->state = PROCESS_READY;
+    ready_process(rq, process, flags);
+}
+
+// 현재 프로세스를 대기 상태로 (timeout 틱 뒤에는 스스로 깨어남, 0이면 깨울 때까지)
+// 전환은 하지 않으므로 호출자는 대기를 등록한 잠금을 놓은 뒤 scheduler_schedule을 호출
+// (그사이 process_wake로 깨워지면 준비 상태로 돌아가 전환 없이 계속 실행)
+void process_prepare_wait(uint32_t timeout) {
+    uint32_t flags = irq_save();
+    scheduler_t* rq = this_rq();
+    process_t* process = rq->current_process;
+    
+    if (process) {
+        spin_lock(&rq->lock);
+        if (timeout) {
+            sleep_locked(rq, process, timeout);
+        } else {
+            dequeue_process(rq, process);
+            process->state = PROCESS_BLOCKED;
+            queue_push_tail(&rq->blocked_queue, process);
+        }
+        spin_unlock(&rq->lock);
+    }
+    irq_restore(flags);
+}
+
+// 블록되었거나 슬립 중인 프로세스 깨우기 (깨웠으면 1)
+int process_wake(process_t* process) {
+    if (!process) return 0;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    if (process->state != PROCESS_BLOCKED && process->state != PROCESS_SLEEPING) {
+        spin_unlock_irqrestore(&rq->lock, flags);
+        return 0;
+    }
+    
+    kernel_timer_cancel(&process->sleep_timer);
+    dequeue_process(rq, process);
+    process->state = PROCESS_READY;
+    ready_process(rq, process, flags);
+    return 1;
+}
+
+// 현재 프로세스 가져오기
+process_t* process_get_current(void) {
+    uint32_t flags = irq_save();
+    process_t* current = this_rq()->current_process;
+    irq_restore(flags);
+    return current;
+}
+
+// 현재 PID 가져오기
+uint32_t process_get_pid(void) {
+    process_t* current = process_get_current();
+    return current ? current->pid : 0;
+}
+
+// ---- CPU 시간 회계 ----
+
+// 마지막 경계부터 지금까지의 TSC 구간을 프로세스(NULL이면 유휴)에 반영 (인터럽트를 끈 상태에서 호출)
+static void account_cputime(scheduler_t* rq, process_t* process, int user) {
+    if (!tsc_khz) return;
+    
+    uint64_t now = tsc_read();
+    uint64_t delta = now - rq->clock_stamp;
+    rq->clock_stamp = now;
+    
+    if (!process) {
+        rq->idle_time += delta;
+    } else if (user) {
+        process->utime += delta;
+    } else {
+        process->stime += delta;
+    }
+}
+
+// 인터럽트나 시스템 콜 진입 (그때까지의 구간은 중단된 모드의 시간)
+void account_kernel_enter(int from_user) {
+    scheduler_t* rq = this_rq();
+    account_cputime(rq, rq->current_process, from_user);
+}
+
+// 복귀 직전 (진입 이후의 구간은 커널 시간)
+void account_kernel_exit(void) {
+    scheduler_t* rq = this_rq();
+    account_cputime(rq, rq->current_process, 0);
+}
+
+// 프로세스의 사용자/커널 실행 시간 (us, 마지막 회계 경계까지이므로 최대 한 틱 늦음)
+void process_get_times(process_t* process, uint64_t* utime_us, uint64_t* stime_us) {
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    uint64_t utime = process->utime;
+    uint64_t stime = process->stime;
+    spin_unlock_irqrestore(&rq->lock, flags);
+    
+    if (utime_us) *utime_us = tsc_cycles_to_us(utime);
+    if (stime_us) *stime_us = tsc_cycles_to_us(stime);
+}
+
+// CPU의 유휴 시간 (us)
+uint64_t scheduler_get_idle_time(uint32_t cpu) {
+    scheduler_t* rq = &smp_get_cpu(cpu)->sched;
+    uint32_t flags = spin_lock_irqsave(&rq->lock);
+    uint64_t idle = rq->idle_time;
+    spin_unlock_irqrestore(&rq->lock, flags);
+    
+    return tsc_cycles_to_us(idle);
+}
+
+// 이 CPU의 틱 장치 설정
+static void tick_set_periodic(void) {
+    if (lapic_tick) {
+        lapic_timer_periodic(tick_counts);
+    } else {
+        pit_set_periodic(timer_frequency);
+    }
+}
+
+static void tick_set_oneshot(uint32_t count) {
+    if (lapic_tick) {
+        lapic_timer_oneshot(count);
+    } else {
+        pit_set_oneshot(count);
+    }
+}
+
+static uint32_t tick_read_count(void) {
+    return lapic_tick ? lapic_timer_read_count() : pit_read_count();
+}
+
+// 타이머 초기화 (BSP, AP의 Local APIC 타이머는 유휴 루프가 일이 생기면 켬)
+void timer_init(uint32_t frequency) {
+    timer_frequency = frequency;
+    open_softirq(SOFTIRQ_TIMER, timer_softirq);
+    
+    // 타이머 인터럽트 핸들러 등록 (매 틱 오므로 빠른 경로)
+    // Local APIC 타이머는 CPU마다 있으므로 다른 CPU에 선점 틱 IPI를 보내지 않아도 됨
+    if (lapic_timer_khz) {
+        lapic_tick = 1;
+        tick_counts = lapic_timer_khz * 1000 / timer_frequency;
+        tick_max_count = 0xFFFFFFFF;
+        set_fast_interrupt_handler(LAPIC_TIMER_VECTOR, timer_interrupt);
+    } else {
+        tick_counts = PIT_FREQUENCY / timer_frequency;
+        tick_max_count = PIT_MAX_COUNT;
+        set_fast_interrupt_handler(IRQ0, timer_interrupt);
+        irq_unmask(0);
+    }
+    
+    tick_set_periodic();
+}
+
+// 주기 틱 멈춤 (가장 가까운 타이머 만료 시점에 단발 인터럽트)
+static void tick_stop(void) {
+    uint32_t max_ticks = tick_max_count / tick_counts;
+    uint32_t delta = timer_wheel_next_expiry() - timer_ticks;
+    
+    if ((int32_t)delta < 1) delta = 1;
+    
+    // 카운터 한계보다 먼 만료는 중간에 한 번 깨어나 시간만 갱신
+    if (delta > max_ticks) delta = max_ticks;
+    
+    // 이미 지난 틱 조각을 빼서 원래 틱 경계에 맞춤
+    oneshot_ticks = delta;
+    oneshot_counts = delta * tick_counts - tick_partial;
+    tick_set_oneshot(oneshot_counts);
+}
+
+// 다른 인터럽트로 깨어났을 때 지난 시간을 반영하고 주기 틱 재개
+// 한 틱 미만의 나머지는 버리지 않고, 다음 틱 경계까지 단발로 기다린 뒤 주기 모드로 (timer_handler)
+static void tick_restart(void) {
+    uint32_t remaining = tick_read_count();
+    if (remaining > oneshot_counts) {
+        remaining = 0; // 이미 만료되어 카운터가 다시 돈 경우
+    }
+    
+    uint32_t elapsed = oneshot_counts - remaining + tick_partial;
+    timer_ticks += elapsed / tick_counts;
+    tick_partial = elapsed % tick_counts;
+    
+    if (tick_partial) {
+        oneshot_ticks = 1;
+        oneshot_counts = tick_counts - tick_partial;
+        tick_set_oneshot(oneshot_counts);
+    } else {
+        oneshot_ticks = 0;
+        tick_set_periodic();
+    }
+}
+
+// 선점 틱 (현재 프로세스의 실행 시간을 반영하고 양보해야 하면 인터럽트 종료 시 재스케줄)
+void scheduler_tick(void) {
+    scheduler_t* rq = this_rq();
+    
+    spin_lock(&rq->lock);
+    process_t* current = rq->current_process;
+    if (current && current->state == PROCESS_RUNNING) {
+        update_current(rq);
+        if (higher_class_ready(rq, current) || current->sched_class->tick(rq, current)) {
+            rq->need_resched = 1;
+        }
+    }
+    spin_unlock(&rq->lock);
+}
+
+// 다른 CPU에 선점 틱 전달 (PIT로 틱을 세면 CPU 0에만 오므로 IPI로 대신, Local APIC 타이머면 각자 받음)
+// 실행 중인 CPU는 선점 여부를 스스로 판단하고, 밀린 CPU가 있으면 유휴 CPU가 깨어나 작업을 훔침
+static void kick_other_cpus(void) {
+    uint32_t this_id = smp_cpu_id();
+    int overloaded = 0;
+    
+    for (uint32_t i = 0; i < smp_cpu_count(); i++) {
+        if (smp_get_cpu(i)->sched.nr_running > 1) {
+            overloaded = 1;
+        }
+    }
+    
+    for (uint32_t i = 0; i < smp_cpu_count(); i++) {
+        scheduler_t* rq = &smp_get_cpu(i)->sched;
+        if (i == this_id) continue;
+        
+        if (rq->current_process) {
+            if (!lapic_tick) {
+                smp_send_tick(smp_get_cpu(i));
+            }
+        } else if (overloaded) {
+            smp_send_reschedule(smp_get_cpu(i));
+        }
+    }
+}
+
+// CPU 0 이외에 실행 중인 CPU가 있는지 (있으면 그 CPU가 보는 timer_ticks와 선점 틱을 위해 주기 틱 유지)
+static int other_cpus_busy(void) {
+    for (uint32_t i = 1; i < smp_cpu_count(); i++) {
+        if (smp_get_cpu(i)->sched.current_process) return 1;
+    }
+    return 0;
+}
+
+// 지수 감쇠 평균 한 단계 (load * exp + active * (1 - exp), 부하가 남아 있으면 올림해서 0으로 수렴하지 않도록)
+static uint32_t calc_load(uint32_t load, uint32_t exp, uint32_t active) {
+    uint32_t new_load = load * exp + active * (FIXED_1 - exp);
+    if (active >= load) {
+        new_load += FIXED_1 - 1;
+    }
+    return new_load >> FSHIFT;
+}
+
+// 로드 평균 갱신 (실행 중이거나 준비 큐에 있는 프로세스 수, 슬립/블록된 프로세스는 제외)
+// 틱을 멈췄던 동안 건너뛴 구간도 같은 값으로 따라잡음
+static void update_load_average(void) {
+    if ((int32_t)(timer_ticks - load_next_update) < 0) return;
+    
+    uint32_t active = 0;
+    for (uint32_t i = 0; i < smp_cpu_count(); i++) {
+        active += smp_get_cpu(i)->sched.nr_running;
+    }
+    active <<= FSHIFT;
+    
+    do {
+        load_averages[0] = calc_load(load_averages[0], EXP_1, active);
+        load_averages[1] = calc_load(load_averages[1], EXP_5, active);
+        load_averages[2] = calc_load(load_averages[2], EXP_15, active);
+        load_next_update += LOAD_FREQ * timer_frequency;
+    } while ((int32_t)(timer_ticks - load_next_update) >= 0);
+}
+
+// 타이머 핸들러 (하드 IRQ에서는 시간과 이 CPU의 선점 틱만, 타이머 휠은 timer softirq에서)
+void timer_handler(void) {
+    // 단발 모드였다면 설정한 틱 수만큼 시간이 지남
+    if (oneshot_ticks) {
+        timer_ticks += oneshot_ticks;
+        oneshot_ticks = 0;
+        tick_partial = 0;
+        tick_set_periodic();
+    } else {
+        timer_ticks++;
+    }
+    
+    scheduler_tick();
+    raise_softirq(SOFTIRQ_TIMER);
+}
+
+// timer softirq (인터럽트를 켠 상태로 실행, 그사이 여러 틱이 지났으면 한 번에 따라잡음)
+static void timer_softirq(void) {
+    uint32_t now = timer_ticks;
+    
+    // 만료된 타이머 처리 (슬립 중인 프로세스 깨우기 포함)
+    timer_wheel_run(now);
+    update_load_average();
+    
+    // 다른 CPU는 10ms마다 선점 여부 판단
+    if ((int32_t)(now - kick_next) >= 0) {
+        kick_next = now - now % SCHED_TICK_INTERVAL + SCHED_TICK_INTERVAL;
+        kick_other_cpus();
+    }
+}
+
+// 타이머 인터럽트 빠른 경로 (공통 인터럽트 처리와 같은 순서로 회계, EOI 뒤에 softirq와 선점)
+// 시간과 타이머 휠은 CPU 0만 갱신하고, 다른 CPU는 자기 Local APIC 타이머로 선점 여부만 판단
+static void timer_interrupt(interrupt_frame_t* frame) {
+    account_kernel_enter((frame->cs & 3) == 3);
+    uint32_t start = irq_stat_start();
+    if (smp_cpu_id() == 0) {
+        timer_handler();
+    } else {
+        scheduler_tick();
+    }
+    
+    if (lapic_tick) {
+        irq_stat_end(LAPIC_TIMER_VECTOR, start);
+        lapic_eoi();
+    } else {
+        irq_stat_end(IRQ0, start);
+        irq_eoi(0);
+    }
+    irq_exit();
+    account_kernel_exit();
+}
+
+// 유휴 루프 (실행할 프로세스가 없으면 hlt, CPU 0은 주기 틱을 단발로, 다른 CPU는 Local APIC 타이머를 멈춤)
+void scheduler_idle(void) {
+    scheduler_t* rq = this_rq();
+    int timer_cpu = smp_cpu_id() == 0;
+    
+    while (1) {
+        __asm__ volatile("cli");
+        
+        // 재시작 한도를 넘겨 남은 softirq
+        if (softirq_pending()) {
+            softirq_run();
+            continue;
+        }
+        
+        // 재스케줄 요청은 다른 CPU에서 작업을 훔쳐 오라는 뜻일 수 있음
+        if (rq->nr_running || rq->need_resched) {
+            if (timer_cpu && oneshot_ticks) {
+                tick_restart();
+            } else if (!timer_cpu && lapic_tick) {
+                tick_set_periodic();
+            }
+            __asm__ volatile("sti");
+            scheduler_schedule();
+            continue;
+        }
+        
+        // 다른 인터럽트로 깨어났을 수 있으므로 매번 다음 만료 시점을 다시 계산
+        if (timer_cpu) {
+            if (oneshot_ticks) {
+                tick_restart();
+            }
+            if (!other_cpus_busy()) {
+                tick_stop();
+            }
+        } else if (lapic_tick) {
+            lapic_timer_stop();
+        }
+        
+        // sti 직후 한 명령은 인터럽트가 지연되므로 검사와 hlt 사이에 깨우기를 놓치지 않음
+        __asm__ volatile("sti; hlt" : : : "memory");
+    }
+}
+
+// 현재 틱 수 가져오기
+uint32_t timer_get_ticks(void) {
+    return timer_ticks;
+}
+
+// 슬립 타이머 만료 (timer softirq에서 호출)
+static void sleep_timeout(void* data) {
+    process_t* process = (process_t*)data;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    
+    // 만료 직후 다른 경로로 깨어나 다시 잠들었으면 (새 타이머가 걸려 있으면) 그 슬립은 건드리지 않음
+    if (process->state != PROCESS_SLEEPING || kernel_timer_pending(&process->sleep_timer)) {
+        spin_unlock_irqrestore(&rq->lock, flags);
+        return;
+    }
+    
+    dequeue_process(rq, process);
+    process->state = PROCESS_READY;
+    ready_process(rq, process, flags);
+}
+
+// 슬립 큐에 추가하고 타이머 휠에 깨어날 시점 등록 (rq 잠금을 잡고 호출)
+static void sleep_locked(scheduler_t* rq, process_t* process, uint32_t ticks) {
+    process->state = PROCESS_SLEEPING;
+    dequeue_process(rq, process);
+    queue_push_tail(&rq->sleeping_queue, process);
+    kernel_timer_add(&process->sleep_timer, ticks, sleep_timeout, process);
+}
+
+// 마감 프로세스 예산 보충 (절대 마감 시점, timer softirq에서 호출)
+static void dl_timer_expired(void* data) {
+    process_t* process = (process_t*)data;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    
+    // 그사이 준비 큐에서 빠졌거나 다시 멈춰 새 타이머가 걸렸으면 무시
+    if (!process->dl_throttled || dl_before(timer_ticks, process->dl_abs_deadline)) {
+        spin_unlock_irqrestore(&rq->lock, flags);
+        return;
+    }
+    
+    process->dl_throttled = 0;
+    rq->nr_running++;
+    dl_replenish(process);
+    dl_tree_insert(rq, process);
+    
+    int preempt = wakeup_preempt(rq, process);
+    uint32_t cpu = process->cpu;
+    spin_unlock_irqrestore(&rq->lock, flags);
+    
+    if (preempt) {
+        smp_send_reschedule(smp_get_cpu(cpu));
+    }
+}
+
+// 타이머 슬립
+void timer_sleep(uint32_t ticks) {
+    uint32_t flags = irq_save();
+    scheduler_t* rq = this_rq();
+    process_t* process = rq->current_process;
+    if (!process) {
+        irq_restore(flags);
+        return;
+    }
+    
+    spin_lock(&rq->lock);
+    sleep_locked(rq, process, ticks);
+    spin_unlock(&rq->lock);
+    
+    scheduler_schedule();
+    irq_restore(flags);
+}
+
+void scheduler_sleep(uint32_t ticks) {
+    timer_sleep(ticks);
+}
+
+// 슬립 중인 프로세스 깨우기 (타이머가 남아 있으면 취소)
+void scheduler_wakeup(process_t* process) {
+    if (!process) return;
+    
+    uint32_t flags;
+    scheduler_t* rq = process_rq_lock(process, &flags);
+    if (process->state != PROCESS_SLEEPING) {
+        spin_unlock_irqrestore(&rq->lock, flags);
+        return;
+    }
+    
+    kernel_timer_cancel(&process->sleep_timer);
+    dequeue_process(rq, process);
+    process->state = PROCESS_READY;
+    ready_process(rq, process, flags);
+}
+
+// 컨텍스트 스위칭 (NULL은 유휴 문맥)
+void context_switch(process_t* from, process_t* to) {
+    cpu_t* cpu = smp_this_cpu();
+    uint32_t* from_esp = from ? &from->esp : &cpu->sched.idle_esp;
+    uint32_t to_esp = to ? to->esp : cpu->sched.idle_esp;
+    
+    uint32_t cr3 = (uint32_t)page_directory_current();
+    
+    if (to) {
+        // 주소 공간이 다를 때만 CR3 교체
+        // 다른 CPU에서 실행되다 돌아왔으면 이 CPU의 TLB에 옛 사용자 매핑이 남아 있을 수 있으므로 다시 로드
+        if (to->cr3 && (to->cr3 != cr3 || to->last_cpu != cpu->id)) {
+            switch_page_directory((page_directory_t*)to->cr3);
+        }
+        to->last_cpu = cpu->id;
+        
+        // 사용자 모드에서 진입할 때 사용할 커널 스택
+        tss_set_kernel_stack(cpu->id, to->stack_top);
+    } else if (cr3 != (uint32_t)page_directory_kernel()) {
+        // 직전 프로세스는 다른 CPU로 깨어나 종료/회수될 수 있으므로 유휴 문맥은
+        // 해제되지 않는 커널 디렉토리에서 실행
+        switch_page_directory(page_directory_kernel());
+    }
+    
+    // 전환 직전까지의 구간은 이전 프로세스(없으면 유휴)의 커널 시간
+    account_cputime(&cpu->sched, from, 0);
+    
+    // 이번 실행 중 사용한 FPU 상태만 저장하고 복원은 다음 사용 시 #NM에서 처리
+    fpu_switch(from);
+    
+    switch_stacks(from_esp, to_esp);
+}
+
+// 스케줄러 통계 출력
+void scheduler_dump_stats(void) {
+    // 간단한 통계 출력
+    uint32_t total = total_processes;
+    uint32_t ready = 0;
+    uint32_t blocked = 0;
+    uint32_t sleeping = 0;
+    
+    // CPU별 준비 큐, 블록된 큐, 슬립 큐 카운트
+    for (uint32_t i = 0; i < smp_cpu_count(); i++) {
+        scheduler_t* rq = &smp_get_cpu(i)->sched;
+        uint32_t flags = spin_lock_irqsave(&rq->lock);
+        
+        for (uint32_t level = 0; level < PRIORITY_LEVELS; level++) {
+            ready += queue_length(rq->run_queue[level]);
+        }
+        ready += rq->nr_fair + rq->nr_dl;
+        blocked += queue_length(rq->blocked_queue);
+        sleeping += queue_length(rq->sleeping_queue);
+        
+        spin_unlock_irqrestore(&rq->lock, flags);
     }
     
     // 통계 출력 (실제 구현에서는 콘솔 출력)
@@ -416,8 +1865,9 @@ void scheduler_dump_stats(void) {
     (void)sleeping;
 }
 
-// 로드 평균 계산
-uint32_t scheduler_get_load_average(void) {
-    // 간단한 로드 평균 계산
-    return scheduler.total_processes;
+// 1/5/15분 로드 평균 (FSHIFT 비트 고정소수점, LOAD_INT/LOAD_FRAC로 출력)
+void scheduler_get_load_average(uint32_t averages[3]) {
+    averages[0] = load_averages[0];
+    averages[1] = load_averages[1];
+    averages[2] = load_averages[2];
 }
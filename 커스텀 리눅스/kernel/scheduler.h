@@ -2,6 +2,9 @@
 #define SCHEDULER_H
 
 #include <stdint.h>
+#include "timer.h"
+#include "spinlock.h"
+#include "rbtree.h"
 
 // 프로세스 상태
 typedef enum {
@@ -20,14 +23,62 @@ typedef enum {
     PRIORITY_REALTIME = 3
 } priority_t;
 
+#define PRIORITY_LEVELS (PRIORITY_REALTIME + 1)
+
+// 스케줄링 정책 (프로세스마다 선택, 마감 정책 → 우선순위 큐 정책 → 공정 정책 순으로 실행)
+typedef enum {
+    SCHED_FAIR = 0,                 // 가상 실행 시간이 가장 작은 프로세스부터 (우선순위는 가중치)
+    SCHED_ROUND_ROBIN = 1,          // 같은 우선순위 안에서 시간 양자마다 순환
+    SCHED_PRIORITY = 2,             // 같은 우선순위 안에서 양보하거나 블록될 때까지 실행
+    SCHED_DEADLINE = 3              // 절대 마감이 가장 이른 프로세스부터 (scheduler_set_deadline으로 설정)
+} sched_policy_t;
+
+struct process;
+struct scheduler;
+
+// 스케줄링 클래스 (정책별 준비 큐 연산, 모두 rq 잠금을 잡은 상태에서 호출)
+// 앞선 클래스에 준비된 프로세스가 있으면 뒤 클래스는 선택되지 않음
+typedef struct sched_class {
+    const char* name;
+    void (*enqueue)(struct scheduler* rq, struct process* process, uint32_t flags);
+    void (*dequeue)(struct scheduler* rq, struct process* process);
+    struct process* (*pick_next)(struct scheduler* rq);                // 다음 실행할 프로세스 (없으면 NULL)
+    int (*tick)(struct scheduler* rq, struct process* current);        // 선점해야 하면 1
+    void (*yield)(struct scheduler* rq, struct process* current);      // 같은 클래스의 다른 프로세스에 양보
+    int (*wakeup_preempt)(struct scheduler* rq, struct process* current, struct process* process);
+    void (*update_curr)(struct scheduler* rq, struct process* current, uint32_t delta); // 실행한 틱 반영 (없으면 NULL)
+    struct process* (*steal)(struct scheduler* rq, uint32_t cpu);      // cpu로 옮길 수 있는 준비된 프로세스
+    void (*migrate_from)(struct scheduler* rq, struct process* process); // 큐 밖의 프로세스가 CPU를 떠날 때 (없으면 NULL)
+    void (*migrate_to)(struct scheduler* rq, struct process* process);   // 새 CPU에 도착했을 때 (없으면 NULL)
+} sched_class_t;
+
+// enqueue 플래그
+#define ENQUEUE_WAKEUP 0x1          // 깨어났거나 새로 생성됨 (공정 정책은 vruntime 재배치)
+
 // 프로세스 구조체
 typedef struct process {
     uint32_t pid;                    // 프로세스 ID
     char name[32];                   // 프로세스 이름
     process_state_t state;           // 프로세스 상태
     priority_t priority;             // 우선순위
-    uint32_t time_slice;            // 남은 시간 슬라이스
-    uint32_t total_time;            // 총 실행 시간
+    sched_policy_t policy;          // 스케줄링 정책
+    const sched_class_t* sched_class; // 정책의 스케줄링 클래스
+    uint32_t on_rq;                 // 준비 큐에 있음 (실행 중인 프로세스 포함)
+    uint32_t slice_start;           // 이번 실행 구간을 시작한 틱
+    uint32_t exec_start;            // 실행 시간을 마지막으로 반영한 틱
+    uint32_t total_time;            // 총 실행 시간 (틱)
+    uint64_t utime;                 // 사용자 모드 실행 시간 (TSC 클럭)
+    uint64_t stime;                 // 커널 모드 실행 시간 (TSC 클럭, 인터럽트 처리 포함)
+    uint64_t vruntime;              // 가중치로 나눈 누적 실행 시간 (us, 공정 정책)
+    rb_node_t run_node;             // 공정/마감 정책 준비 트리 노드 (트리에 없으면 RB_EMPTY_NODE)
+    uint32_t dl_runtime;            // 주기마다 보장하는 실행 시간 (틱, 마감 정책)
+    uint32_t dl_deadline;           // 주기 시작부터의 상대 마감 (틱)
+    uint32_t dl_period;             // 주기 (틱)
+    uint32_t dl_bw;                 // 승인된 대역폭 (runtime/period, 16비트 고정소수점)
+    int32_t dl_budget;              // 이번 마감까지 남은 실행 시간 (틱, 초과하면 음수)
+    uint32_t dl_abs_deadline;       // 절대 마감 (틱, 준비 트리의 키)
+    uint32_t dl_throttled;          // 예산을 다 써서 보충을 기다리는 중 (준비 트리 밖)
+    kernel_timer_t dl_timer;        // 예산 보충 타이머
     uint32_t stack_top;             // 스택 최상단
     uint32_t stack_bottom;          // 스택 최하단
     uint32_t esp;                   // 현재 스택 포인터
@@ -35,23 +86,57 @@ typedef struct process {
     uint32_t eip;                   // 명령어 포인터
     uint32_t eflags;                // 플래그 레지스터
     uint32_t cr3;                   // 페이지 디렉토리
+    struct vm_area* vm_areas;       // 가상 메모리 영역 리스트
+    struct vm_area* heap_area;      // 사용자 힙 영역 (brk)
     struct process* next;           // 다음 프로세스
     struct process* prev;           // 이전 프로세스
+    struct process** queue;         // 속한 큐의 헤드 (큐에 없으면 NULL)
+    kernel_timer_t sleep_timer;     // 슬립 만료 타이머
+    void* fpu_state;                // FXSAVE 영역 (FPU를 처음 쓸 때 할당)
+    uint32_t fpu_cpu;               // 마지막으로 FPU 상태를 불러온 CPU
+    uint32_t cpu;                   // 속한 준비/대기 큐의 CPU (그 CPU의 잠금으로 보호)
+    uint32_t last_cpu;              // 마지막으로 실행된 CPU
+    uint32_t affinity;              // 실행할 수 있는 CPU 비트마스크
+    uint32_t trap_frame;            // 진행 중인 시스템 콜의 트랩 프레임 (커널 스택 위쪽, fork가 복사)
+    uint32_t trap_eax_offset;       // 프레임 안의 eax 위치 (자식의 반환값 0)
+    void (*trap_return)(void);      // 프레임으로 사용자 모드에 돌아가는 경로 (isr.asm)
+    void (*kthread_fn)(void* data); // 커널 스레드 본체 (kthread_create로 만든 경우)
+    void* kthread_data;             // 커널 스레드 본체에 넘길 인자
 } process_t;
 
-// 스케줄러 구조체
+// 스케줄러 구조체 (CPU마다 하나)
 typedef struct scheduler {
+    spinlock_t lock;                // 큐와 current_process 보호 (전환 중에는 계속 잡고 있음)
     process_t* current_process;     // 현재 실행 중인 프로세스
-    process_t* ready_queue;         // 준비 큐
+    process_t* run_queue[PRIORITY_LEVELS]; // 우선순위별 준비 큐 (FIFO)
+    uint32_t run_bitmap;            // 비어 있지 않은 준비 큐 비트맵
+    uint32_t nr_running;            // 준비 큐의 프로세스 수 (실행 중인 프로세스 포함, 예산 보충을 기다리는 마감 프로세스 제외)
+    rb_root_t fair_tree;            // 공정 정책 준비 트리 (vruntime 순, 실행 중인 프로세스 포함)
+    uint32_t nr_fair;               // 준비 트리의 프로세스 수
+    uint32_t fair_load;             // 준비 트리의 가중치 합
+    uint64_t min_vruntime;          // 준비 트리의 가장 작은 vruntime (단조 증가, CPU 간 이동의 기준)
+    rb_root_t dl_tree;              // 마감 정책 준비 트리 (절대 마감 순, 실행 중인 프로세스 포함)
+    uint32_t nr_dl;                 // 마감 준비 트리의 프로세스 수
     process_t* blocked_queue;       // 블록된 큐
     process_t* sleeping_queue;      // 슬립 큐
-    uint32_t next_pid;             // 다음 PID
-    uint32_t total_processes;      // 총 프로세스 수
     uint32_t time_quantum;         // 시간 양자
+    volatile uint32_t need_resched; // 인터럽트 종료 시 재스케줄 필요
+    process_t* migrate_process;     // 전환 후 다른 CPU로 옮길 이전 프로세스 (친화성 변경)
+    process_t* dead_process;        // 전환 후 회수 목록에 넣을 종료한 이전 프로세스
+    uint32_t idle_esp;              // 유휴 문맥의 저장된 스택 포인터
+    uint64_t clock_stamp;           // 마지막 CPU 시간 회계 경계의 TSC
+    uint64_t idle_time;             // 유휴 시간 (TSC 클럭)
 } scheduler_t;
 
+// 로드 평균 (실행 가능한 프로세스 수의 1/5/15분 지수 감쇠 평균, FSHIFT 비트 고정소수점)
+#define FSHIFT 11
+#define FIXED_1 (1 << FSHIFT)
+#define LOAD_INT(x) ((x) >> FSHIFT)
+#define LOAD_FRAC(x) LOAD_INT(((x) & (FIXED_1 - 1)) * 100)
+
 // 스케줄러 함수들
 void scheduler_init(void);
+void scheduler_init_cpu(scheduler_t* rq);
 void scheduler_add_process(process_t* process);
 void scheduler_remove_process(process_t* process);
 void scheduler_schedule(void);
@@ -59,19 +144,33 @@ void scheduler_yield(void);
 void scheduler_sleep(uint32_t ticks);
 void scheduler_wakeup(process_t* process);
 void scheduler_set_priority(process_t* process, priority_t priority);
+void scheduler_set_policy(process_t* process, sched_policy_t policy);
+void scheduler_set_default_policy(sched_policy_t policy);
+int scheduler_set_deadline(process_t* process, uint32_t runtime, uint32_t deadline, uint32_t period);
+void scheduler_tick(void);
+void scheduler_idle(void);
+void scheduler_irq_exit(void);
+void scheduler_finish_switch(void);
+int scheduler_set_affinity(process_t* process, uint32_t mask);
 
 // 프로세스 관리 함수들
 process_t* process_create(const char* name, void (*entry_point)(void), priority_t priority);
+process_t* kthread_create(const char* name, void (*fn)(void* data), void* data, priority_t priority);
 void process_destroy(process_t* process);
+process_t* process_fork(process_t* parent);
+void process_exit(void);
 void process_block(process_t* process);
 void process_unblock(process_t* process);
+void process_prepare_wait(uint32_t timeout);
+int process_wake(process_t* process);
+process_t* process_reap(void);
 process_t* process_get_current(void);
 uint32_t process_get_pid(void);
 
-// 스케줄링 알고리즘
-void scheduler_round_robin(void);
-void scheduler_priority(void);
-void scheduler_multilevel_feedback(void);
+// 스케줄링 클래스 (우선순위 큐 클래스는 라운드 로빈과 우선순위 정책을 함께 처리)
+extern const sched_class_t deadline_sched_class;
+extern const sched_class_t priority_sched_class;
+extern const sched_class_t fair_sched_class;
 
 // 타이머 관련
 void timer_init(uint32_t frequency);
@@ -79,13 +178,21 @@ void timer_handler(void);
 uint32_t timer_get_ticks(void);
 void timer_sleep(uint32_t ticks);
 
-// 컨텍스트 스위칭
+// 컨텍스트 스위칭 (switch_stacks, process_trampoline, fork_trampoline은 switch.asm)
+// 전환 전에 잡은 스케줄러 잠금은 전환되어 온 문맥이 scheduler_finish_switch로 해제
 void context_switch(process_t* from, process_t* to);
-void save_context(process_t* process);
-void restore_context(process_t* process);
+void switch_stacks(uint32_t* old_esp, uint32_t new_esp);
+void process_trampoline(void);
+void fork_trampoline(void);
+
+// CPU 시간 회계 (인터럽트와 시스템 콜 진입/복귀, 문맥 전환 때마다 TSC 구간을 나눠 반영)
+void account_kernel_enter(int from_user);
+void account_kernel_exit(void);
+void process_get_times(process_t* process, uint64_t* utime_us, uint64_t* stime_us);
+uint64_t scheduler_get_idle_time(uint32_t cpu);
 
 // 스케줄러 통계
 void scheduler_dump_stats(void);
-uint32_t scheduler_get_load_average(void);
+void scheduler_get_load_average(uint32_t averages[3]);
 
 #endif // SCHEDULER_H
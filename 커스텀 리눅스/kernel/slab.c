@@ -0,0 +1,233 @@
+#include "slab.h"
+#include "memory.h"
+#include "buddy.h"
+#include <string.h>
+
+#define SLAB_MIN_OBJECTS 8          // 슬랩당 최소 객체 수 목표
+#define SLAB_MAX_ORDER 4            // 최대 슬랩 크기 (64KB)
+
+static kmem_cache_t* cache_list = NULL;
+static spinlock_t cache_list_lock = SPINLOCK_INIT;
+
+// 슬랩 리스트에 추가
+static void slab_list_add(kmem_slab_t** list, kmem_slab_t* slab) {
+    slab->prev = NULL;
+    slab->next = *list;
+    if (*list) {
+        (*list)->prev = slab;
+    }
+    *list = slab;
+}
+
+// 슬랩 리스트에서 제거
+static void slab_list_remove(kmem_slab_t** list, kmem_slab_t* slab) {
+    if (slab->prev) {
+        slab->prev->next = slab->next;
+    } else {
+        *list = slab->next;
+    }
+    if (slab->next) {
+        slab->next->prev = slab->prev;
+    }
+    slab->next = NULL;
+    slab->prev = NULL;
+}
+
+// 슬랩 헤더 뒤 첫 객체 위치
+static uint32_t slab_first_offset(uint32_t objects, uint32_t align) {
+    uint32_t header = sizeof(kmem_slab_t) + objects * sizeof(uint16_t);
+    return (header + align - 1) & ~(align - 1);
+}
+
+// 객체가 속한 슬랩 (슬랩은 자기 크기로 정렬되어 있음)
+static kmem_slab_t* object_to_slab(kmem_cache_t* cache, void* object) {
+    return (kmem_slab_t*)((uint32_t)object & ~(cache->slab_size - 1));
+}
+
+// 새 슬랩 생성
+static kmem_slab_t* slab_grow(kmem_cache_t* cache) {
+    // 버디 블록은 자기 크기로 정렬되어 있어 주소 마스킹으로 슬랩을 찾을 수 있음
+    kmem_slab_t* slab = (kmem_slab_t*)page_alloc(cache->slab_order);
+    if (!slab) return NULL;
+    
+    slab->cache = cache;
+    slab->next = NULL;
+    slab->prev = NULL;
+    slab->free_count = cache->objects_per_slab;
+    
+    // 낮은 주소부터 꺼내지도록 인덱스를 역순으로 쌓음
+    uint32_t base = (uint32_t)slab + cache->first_offset;
+    for (uint32_t i = 0; i < cache->objects_per_slab; i++) {
+        slab->free_index[i] = cache->objects_per_slab - 1 - i;
+        
+        if (cache->ctor) {
+            cache->ctor((void*)(base + i * cache->object_size));
+        }
+    }
+    
+    cache->slab_count++;
+    return slab;
+}
+
+// 슬랩 반환
+static void slab_release(kmem_cache_t* cache, kmem_slab_t* slab) {
+    cache->slab_count--;
+    page_free(slab, cache->slab_order);
+}
+
+// 캐시 생성
+kmem_cache_t* kmem_cache_create(const char* name, size_t size, size_t align, kmem_ctor_t ctor) {
+    if (size == 0) return NULL;
+    
+    // 정렬은 2의 거듭제곱, 최소 힙 정렬 단위
+    if (align < HEAP_ALIGN) {
+        align = HEAP_ALIGN;
+    }
+    if (align & (align - 1)) return NULL;
+    
+    uint32_t object_size = (size + align - 1) & ~(align - 1);
+    
+    // 객체가 충분히 들어가는 가장 작은 슬랩 크기 선택
+    uint32_t slab_order = 0;
+    uint32_t slab_size = PAGE_SIZE;
+    uint32_t objects = 0;
+    for (;;) {
+        objects = (slab_size - sizeof(kmem_slab_t)) / (object_size + sizeof(uint16_t));
+        while (objects && slab_first_offset(objects, align) + objects * object_size > slab_size) {
+            objects--;
+        }
+        
+        if (objects >= SLAB_MIN_OBJECTS || slab_order >= SLAB_MAX_ORDER) break;
+        slab_order++;
+        slab_size <<= 1;
+    }
+    if (objects == 0) return NULL; // 너무 큰 객체
+    
+    kmem_cache_t* cache = (kmem_cache_t*)kmalloc(sizeof(kmem_cache_t));
+    if (!cache) return NULL;
+    
+    memset(cache, 0, sizeof(kmem_cache_t));
+    strncpy(cache->name, name, 31);
+    cache->name[31] = '\0';
+    cache->object_size = object_size;
+    cache->align = align;
+    cache->slab_size = slab_size;
+    cache->slab_order = slab_order;
+    cache->first_offset = slab_first_offset(objects, align);
+    cache->objects_per_slab = objects;
+    cache->ctor = ctor;
+    spin_lock_init(&cache->lock);
+    
+    uint32_t flags = spin_lock_irqsave(&cache_list_lock);
+    cache->next = cache_list;
+    cache_list = cache;
+    spin_unlock_irqrestore(&cache_list_lock, flags);
+    
+    return cache;
+}
+
+// 캐시 제거 (모든 객체가 반환된 상태여야 함)
+void kmem_cache_destroy(kmem_cache_t* cache) {
+    if (!cache) return;
+    
+    kmem_slab_t** lists[3] = { &cache->partial_slabs, &cache->full_slabs, &cache->empty_slabs };
+    for (int i = 0; i < 3; i++) {
+        while (*lists[i]) {
+            kmem_slab_t* slab = *lists[i];
+            slab_list_remove(lists[i], slab);
+            slab_release(cache, slab);
+        }
+    }
+    
+    // 캐시 리스트에서 제거
+    uint32_t flags = spin_lock_irqsave(&cache_list_lock);
+    kmem_cache_t** link = &cache_list;
+    while (*link && *link != cache) {
+        link = &(*link)->next;
+    }
+    if (*link) {
+        *link = cache->next;
+    }
+    spin_unlock_irqrestore(&cache_list_lock, flags);
+    
+    kfree(cache);
+}
+
+// 객체 할당
+void* kmem_cache_alloc(kmem_cache_t* cache) {
+    if (!cache) return NULL;
+    
+    uint32_t flags = spin_lock_irqsave(&cache->lock);
+    kmem_slab_t* slab = cache->partial_slabs;
+    if (!slab) {
+        slab = cache->empty_slabs;
+        if (slab) {
+            slab_list_remove(&cache->empty_slabs, slab);
+        } else {
+            slab = slab_grow(cache);
+            if (!slab) {
+                spin_unlock_irqrestore(&cache->lock, flags);
+                return NULL;
+            }
+        }
+        slab_list_add(&cache->partial_slabs, slab);
+    }
+    
+    uint32_t index = slab->free_index[--slab->free_count];
+    if (slab->free_count == 0) {
+        slab_list_remove(&cache->partial_slabs, slab);
+        slab_list_add(&cache->full_slabs, slab);
+    }
+    
+    cache->active_objects++;
+    spin_unlock_irqrestore(&cache->lock, flags);
+    return (void*)((uint32_t)slab + cache->first_offset + index * cache->object_size);
+}
+
+// 객체 반환
+void kmem_cache_free(kmem_cache_t* cache, void* object) {
+    if (!cache || !object) return;
+    
+    kmem_slab_t* slab = object_to_slab(cache, object);
+    if (slab->cache != cache) return; // 다른 캐시의 객체
+    
+    uint32_t index = ((uint32_t)object - (uint32_t)slab - cache->first_offset) / cache->object_size;
+    
+    uint32_t flags = spin_lock_irqsave(&cache->lock);
+    if (slab->free_count == 0) {
+        slab_list_remove(&cache->full_slabs, slab);
+        slab_list_add(&cache->partial_slabs, slab);
+    }
+    
+    slab->free_index[slab->free_count++] = index;
+    cache->active_objects--;
+    
+    // 완전히 빈 슬랩은 하나만 남기고 힙에 반환
+    if (slab->free_count == cache->objects_per_slab) {
+        slab_list_remove(&cache->partial_slabs, slab);
+        if (cache->empty_slabs) {
+            slab_release(cache, slab);
+        } else {
+            slab_list_add(&cache->empty_slabs, slab);
+        }
+    }
+    spin_unlock_irqrestore(&cache->lock, flags);
+}
+
+// 캐시 통계 출력
+void kmem_cache_dump_stats(void) {
+    // 간단한 통계 출력 (실제 구현에서는 콘솔 출력 함수 필요)
+    uint32_t caches = 0;
+    uint32_t slabs = 0;
+    uint32_t objects = 0;
+    
+    for (kmem_cache_t* cache = cache_list; cache; cache = cache->next) {
+        caches++;
+        slabs += cache->slab_count;
+        objects += cache->active_objects;
+    }
+    
+    (void)caches;
+    (void)slabs;
+    (void)objects;
+}
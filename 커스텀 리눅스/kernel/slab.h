@@ -0,0 +1,46 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "spinlock.h"
+
+// 객체 생성자 (슬랩이 만들어질 때 객체마다 한 번 호출)
+typedef void (*kmem_ctor_t)(void* object);
+
+// 슬랩 구조체 (슬랩 메모리의 맨 앞에 위치)
+typedef struct kmem_slab {
+    struct kmem_cache* cache;       // 소속 캐시
+    struct kmem_slab* next;         // 같은 상태 리스트의 다음 슬랩
+    struct kmem_slab* prev;         // 같은 상태 리스트의 이전 슬랩
+    uint32_t free_count;            // 빈 객체 수
+    uint16_t free_index[];          // 빈 객체 인덱스 스택 (객체 내용은 건드리지 않음)
+} kmem_slab_t;
+
+// 객체 캐시 구조체
+typedef struct kmem_cache {
+    char name[32];                  // 캐시 이름
+    uint32_t object_size;           // 객체 크기 (정렬 포함)
+    uint32_t align;                 // 객체 정렬
+    uint32_t slab_size;             // 슬랩 크기 (2의 거듭제곱, 슬랩 정렬 단위)
+    uint32_t slab_order;            // 슬랩 페이지 차수
+    uint32_t first_offset;          // 슬랩 안 첫 객체 오프셋
+    uint32_t objects_per_slab;      // 슬랩당 객체 수
+    kmem_ctor_t ctor;               // 생성자
+    kmem_slab_t* partial_slabs;     // 일부 사용 중인 슬랩
+    kmem_slab_t* full_slabs;        // 가득 찬 슬랩
+    kmem_slab_t* empty_slabs;       // 비어 있는 슬랩 (재사용 대기)
+    uint32_t slab_count;            // 전체 슬랩 수
+    uint32_t active_objects;        // 사용 중인 객체 수
+    struct kmem_cache* next;        // 캐시 리스트
+    spinlock_t lock;                // 슬랩 리스트 보호
+} kmem_cache_t;
+
+// 슬랩 캐시 함수들
+kmem_cache_t* kmem_cache_create(const char* name, size_t size, size_t align, kmem_ctor_t ctor);
+void kmem_cache_destroy(kmem_cache_t* cache);
+void* kmem_cache_alloc(kmem_cache_t* cache);
+void kmem_cache_free(kmem_cache_t* cache, void* object);
+void kmem_cache_dump_stats(void);
+
+#endif // SLAB_H
@@ -0,0 +1,157 @@
+#include "smp.h"
+#include "acpi.h"
+#include "apic.h"
+#include "interrupt.h"
+#include "memory.h"
+#include "buddy.h"
+#include "fpu.h"
+#include "irqstat.h"
+#include "softirq.h"
+#include <string.h>
+
+// AP 시작 절차의 대기 시간 (Intel MP 사양의 INIT-SIPI-SIPI)
+#define INIT_DELAY_US 10000
+#define SIPI_DELAY_US 200
+#define AP_BOOT_TIMEOUT_US 100000
+
+cpu_t smp_cpus[SMP_MAX_CPUS];
+static uint32_t cpu_count = 1;
+static uint32_t online_mask = 1;        // BSP는 처음부터 실행 중
+static cpu_t* volatile booting_cpu = NULL;  // 부팅 중인 AP (한 번에 하나씩)
+
+// ap_boot.asm의 트램펄린 코드와 부팅 정보 위치
+extern uint8_t ap_trampoline_start[];
+extern uint8_t ap_trampoline_end[];
+extern uint8_t ap_boot_data[];
+
+typedef struct {
+    uint32_t cr3;
+    uint32_t cr4;
+    uint32_t stack;                 // AP 유휴 스택 꼭대기
+    uint32_t entry;                 // smp_ap_main
+    gdtr_t gdtr;
+} __attribute__((packed)) ap_boot_data_t;
+
+// 포트 0x80 쓰기는 약 1us 걸림 (타이머 인터럽트를 켜기 전의 짧은 대기용)
+static void udelay(uint32_t us) {
+    while (us--) {
+        __asm__ volatile("outb %%al, $0x80" : : "a" (0));
+    }
+}
+
+// 재스케줄 IPI와 선점 틱 (need_resched는 보낸 쪽이나 선점 틱이 설정, 인터럽트 종료 시 처리)
+// Local APIC 타이머를 보정하지 못했으면 다른 CPU의 틱마다 오므로 빠른 경로
+static void reschedule_ipi_handler(interrupt_frame_t* frame) {
+    account_kernel_enter((frame->cs & 3) == 3);
+    uint32_t start = irq_stat_start();
+    scheduler_tick();
+    irq_stat_end(RESCHEDULE_VECTOR, start);
+    lapic_eoi();
+    irq_exit();
+    account_kernel_exit();
+}
+
+// INIT-SIPI-SIPI로 AP 하나를 깨우고 온라인이 될 때까지 대기
+static int smp_boot_ap(cpu_t* cpu) {
+    ap_boot_data_t* data = (ap_boot_data_t*)(AP_TRAMPOLINE_ADDR + (ap_boot_data - ap_trampoline_start));
+    
+    cpu->idle_stack = (uint32_t)page_alloc(0);
+    if (!cpu->idle_stack) return -1;
+    
+    data->stack = cpu->idle_stack + PAGE_SIZE;
+    data->entry = (uint32_t)smp_ap_main;
+    booting_cpu = cpu;
+    
+    lapic_send_ipi(cpu->apic_id, LAPIC_ICR_INIT | LAPIC_ICR_LEVEL_ASSERT);
+    udelay(INIT_DELAY_US);
+    
+    // 첫 SIPI를 놓치는 CPU가 있으므로 응답이 없으면 한 번 더
+    for (int i = 0; i < 2 && !cpu->online; i++) {
+        lapic_send_ipi(cpu->apic_id, LAPIC_ICR_STARTUP | (AP_TRAMPOLINE_ADDR >> 12));
+        udelay(SIPI_DELAY_US);
+    }
+    
+    for (uint32_t waited = 0; !cpu->online && waited < AP_BOOT_TIMEOUT_US; waited++) {
+        udelay(1);
+    }
+    
+    booting_cpu = NULL;
+    if (!cpu->online) {
+        page_free((void*)cpu->idle_stack, 0);
+        cpu->idle_stack = 0;
+        return -1;
+    }
+    return 0;
+}
+
+// SMP 초기화 (MADT에 있는 AP를 차례로 부팅, apic_init이 Local APIC를 찾지 못했으면 단일 CPU로 계속)
+void smp_init(void) {
+    if (!lapic_available()) return;
+    
+    const acpi_madt_info_t* madt = acpi_get_madt();
+    
+    cpu_t* bsp = &smp_cpus[0];
+    bsp->apic_id = lapic_id();
+    bsp->online = 1;
+    
+    set_fast_interrupt_handler(RESCHEDULE_VECTOR, reschedule_ipi_handler);
+    
+    // 트램펄린 복사와 모든 AP에 공통인 부팅 정보 (커널 페이지 디렉토리, CR4, GDT)
+    memcpy((void*)AP_TRAMPOLINE_ADDR, ap_trampoline_start, ap_trampoline_end - ap_trampoline_start);
+    ap_boot_data_t* data = (ap_boot_data_t*)(AP_TRAMPOLINE_ADDR + (ap_boot_data - ap_trampoline_start));
+    __asm__ volatile("mov %%cr3, %0" : "=r" (data->cr3));
+    __asm__ volatile("mov %%cr4, %0" : "=r" (data->cr4));
+    __asm__ volatile("sgdt %0" : "=m" (data->gdtr));
+    
+    for (uint32_t i = 0; i < madt->cpu_count && cpu_count < SMP_MAX_CPUS; i++) {
+        if (madt->cpu_apic_ids[i] == bsp->apic_id) continue;
+        
+        cpu_t* cpu = &smp_cpus[cpu_count];
+        cpu->id = cpu_count;
+        cpu->apic_id = madt->cpu_apic_ids[i];
+        scheduler_init_cpu(&cpu->sched);
+        
+        if (smp_boot_ap(cpu) == 0) {
+            online_mask |= 1u << cpu_count;
+            cpu_count++;
+        }
+    }
+}
+
+// AP의 C 진입점 (트램펄린이 보호 모드와 페이징을 켜고 유휴 스택에서 호출)
+void smp_ap_main(void) {
+    cpu_t* cpu = booting_cpu;
+    
+    gdt_load(cpu->id);
+    idt_load();
+    lapic_enable();
+    fpu_init_cpu();
+    
+    cpu->online = 1;
+    
+    // 이후로는 이 CPU의 유휴 문맥 (작업 훔치기와 IPI로 프로세스를 받음)
+    scheduler_idle();
+}
+
+uint32_t smp_cpu_count(void) {
+    return cpu_count;
+}
+
+uint32_t smp_online_mask(void) {
+    return online_mask;
+}
+
+// 다른 CPU에 재스케줄 요청 (자기 자신이면 인터럽트 종료 시 처리)
+void smp_send_reschedule(cpu_t* cpu) {
+    cpu->sched.need_resched = 1;
+    if (cpu != smp_this_cpu() && cpu->online) {
+        lapic_send_ipi(cpu->apic_id, LAPIC_ICR_FIXED | RESCHEDULE_VECTOR);
+    }
+}
+
+// 선점 틱 전달 (재스케줄 여부는 받는 CPU가 판단)
+void smp_send_tick(cpu_t* cpu) {
+    if (cpu != smp_this_cpu() && cpu->online) {
+        lapic_send_ipi(cpu->apic_id, LAPIC_ICR_FIXED | RESCHEDULE_VECTOR);
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef SMP_H
+#define SMP_H
+
+#include <stdint.h>
+#include "gdt.h"
+#include "scheduler.h"
+
+// 지원하는 최대 CPU 수 (CPU마다 GDT에 TSS 하나)
+#define SMP_MAX_CPUS GDT_TSS_COUNT
+#define SMP_ALL_CPUS 0xFFFFFFFF     // 친화성 기본값
+#define SMP_NO_CPU 0xFFFFFFFF
+
+// AP 부팅 트램펄린 위치 (1MB 미만 4KB 정렬, SIPI 벡터 = 주소 >> 12, ap_boot.asm과 일치)
+#define AP_TRAMPOLINE_ADDR 0x1000
+
+// 재스케줄 IPI 벡터 (다른 CPU의 준비 큐에 프로세스를 넣었거나 선점 틱)
+#define RESCHEDULE_VECTOR 0xF0
+
+// CPU별 상태
+typedef struct cpu {
+    uint32_t id;                    // 논리 CPU 번호 (BSP = 0)
+    uint32_t apic_id;               // Local APIC ID
+    volatile uint32_t online;       // 부팅 완료
+    scheduler_t sched;              // 이 CPU의 준비 큐와 현재 프로세스
+    struct process* fpu_owner;      // FPU 레지스터에 상태가 올라가 있는 프로세스
+    uint32_t fpu_used;              // 현재 프로세스가 이번 실행 중 FPU를 사용함
+    uint32_t idle_stack;            // 유휴 문맥 스택 (AP, BSP는 부팅 스택)
+} cpu_t;
+
+extern cpu_t smp_cpus[SMP_MAX_CPUS];
+
+// 현재 CPU 번호 (TR의 TSS 셀렉터로 구함, 메모리 접근 없이 인터럽트 안에서도 사용 가능)
+static inline uint32_t smp_cpu_id(void) {
+    uint16_t selector;
+    __asm__ volatile("str %0" : "=r" (selector));
+    return selector >= GDT_TSS ? (uint32_t)(selector - GDT_TSS) >> 3 : 0;
+}
+
+// 현재 CPU (선점으로 다른 CPU로 옮겨질 수 있으므로 인터럽트를 끈 상태에서 사용)
+static inline cpu_t* smp_this_cpu(void) {
+    return &smp_cpus[smp_cpu_id()];
+}
+
+static inline cpu_t* smp_get_cpu(uint32_t id) {
+    return &smp_cpus[id];
+}
+
+// SMP 관련 함수들
+void smp_init(void);
+void smp_ap_main(void);
+uint32_t smp_cpu_count(void);
+uint32_t smp_online_mask(void);
+void smp_send_reschedule(cpu_t* cpu);
+void smp_send_tick(cpu_t* cpu);
+
+#endif // SMP_H
@@ -0,0 +1,135 @@
+#include "softirq.h"
+#include "interrupt.h"
+#include "scheduler.h"
+#include "smp.h"
+
+// CPU별 보류 상태 (그 CPU에서 인터럽트를 끄고만 접근하므로 잠금 없음)
+typedef struct {
+    volatile uint32_t pending;      // 종류별 보류 비트
+    uint32_t active;                // softirq 처리 중 (중첩된 IRQ 종료는 바깥 처리에 맡김)
+    tasklet_t* tasklet_head;        // 예약된 태스클릿 (FIFO)
+    tasklet_t* tasklet_tail;
+} softirq_cpu_t;
+
+static softirq_cpu_t softirq_cpus[SMP_MAX_CPUS];
+
+static void tasklet_action(void);
+
+static softirq_handler_t softirq_handlers[SOFTIRQ_COUNT] = {
+    [SOFTIRQ_TASKLET] = tasklet_action,
+};
+
+// softirq 핸들러 등록 (부팅 중에)
+void open_softirq(uint32_t nr, softirq_handler_t handler) {
+    if (nr < SOFTIRQ_COUNT) {
+        softirq_handlers[nr] = handler;
+    }
+}
+
+// 이 CPU에 softirq 표시 (처리는 IRQ 종료 시)
+void raise_softirq(uint32_t nr) {
+    uint32_t flags = irq_save();
+    softirq_cpus[smp_cpu_id()].pending |= 1u << nr;
+    irq_restore(flags);
+}
+
+// 이 CPU의 보류 비트 (인터럽트를 끈 상태에서 호출)
+uint32_t softirq_pending(void) {
+    return softirq_cpus[smp_cpu_id()].pending;
+}
+
+// 보류된 softirq 처리 (핸들러는 인터럽트를 켠 상태로 실행, 처리 중에 들어온 IRQ는 보류 비트만 추가)
+// 프로세스 전환은 하지 않으므로 실행 중 CPU가 바뀌지 않음
+void softirq_run(void) {
+    uint32_t flags = irq_save();
+    softirq_cpu_t* cpu = &softirq_cpus[smp_cpu_id()];
+    if (cpu->active) {
+        irq_restore(flags);
+        return;
+    }
+    
+    cpu->active = 1;
+    for (uint32_t round = 0; round < SOFTIRQ_MAX_RESTART && cpu->pending; round++) {
+        uint32_t pending = cpu->pending;
+        cpu->pending = 0;
+        enable_interrupts();
+        
+        for (uint32_t nr = 0; nr < SOFTIRQ_COUNT; nr++) {
+            if ((pending & (1u << nr)) && softirq_handlers[nr]) {
+                softirq_handlers[nr]();
+            }
+        }
+        disable_interrupts();
+    }
+    cpu->active = 0;
+    irq_restore(flags);
+}
+
+// IRQ 종료 (EOI 뒤, 인터럽트를 끈 상태에서 호출)
+// softirq 처리 중에 끼어든 IRQ면 바깥 처리가 끝난 뒤 선점하도록 그대로 돌아감
+void irq_exit(void) {
+    if (softirq_cpus[smp_cpu_id()].active) return;
+    
+    if (softirq_pending()) {
+        softirq_run();
+    }
+    scheduler_irq_exit();
+}
+
+// 태스클릿 초기화
+void tasklet_init(tasklet_t* tasklet, void (*func)(void* data), void* data) {
+    tasklet->next = NULL;
+    tasklet->state = 0;
+    tasklet->func = func;
+    tasklet->data = data;
+}
+
+// 이 CPU의 태스클릿 목록 끝에 추가 (인터럽트를 끈 상태에서 호출)
+static void tasklet_enqueue(softirq_cpu_t* cpu, tasklet_t* tasklet) {
+    tasklet->next = NULL;
+    if (cpu->tasklet_tail) {
+        cpu->tasklet_tail->next = tasklet;
+    } else {
+        cpu->tasklet_head = tasklet;
+    }
+    cpu->tasklet_tail = tasklet;
+}
+
+// 태스클릿 예약 (이미 예약되어 있으면 무시, 실행 중이면 끝난 뒤 한 번 더 실행)
+void tasklet_schedule(tasklet_t* tasklet) {
+    if (__sync_fetch_and_or(&tasklet->state, TASKLET_SCHEDULED) & TASKLET_SCHEDULED) return;
+    
+    uint32_t flags = irq_save();
+    softirq_cpu_t* cpu = &softirq_cpus[smp_cpu_id()];
+    tasklet_enqueue(cpu, tasklet);
+    cpu->pending |= 1u << SOFTIRQ_TASKLET;
+    irq_restore(flags);
+}
+
+// 태스클릿 softirq (목록을 통째로 가져와 실행, 다른 CPU에서 실행 중인 것은 다음 차례로 미룸)
+static void tasklet_action(void) {
+    uint32_t flags = irq_save();
+    softirq_cpu_t* cpu = &softirq_cpus[smp_cpu_id()];
+    tasklet_t* list = cpu->tasklet_head;
+    cpu->tasklet_head = NULL;
+    cpu->tasklet_tail = NULL;
+    irq_restore(flags);
+    
+    while (list) {
+        tasklet_t* tasklet = list;
+        list = list->next;
+        
+        if (__sync_fetch_and_or(&tasklet->state, TASKLET_RUNNING) & TASKLET_RUNNING) {
+            flags = irq_save();
+            tasklet_enqueue(cpu, tasklet);
+            cpu->pending |= 1u << SOFTIRQ_TASKLET;
+            irq_restore(flags);
+            continue;
+        }
+        
+        // 실행 전에 예약 표시를 지워 본체가 다시 예약할 수 있도록
+        __sync_fetch_and_and(&tasklet->state, ~TASKLET_SCHEDULED);
+        tasklet->func(tasklet->data);
+        __sync_fetch_and_and(&tasklet->state, ~TASKLET_RUNNING);
+    }
+}
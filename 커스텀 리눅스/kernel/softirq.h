@@ -0,0 +1,41 @@
+#ifndef SOFTIRQ_H
+#define SOFTIRQ_H
+
+#include <stdint.h>
+
+// 인터럽트 뒤처리 (하드 IRQ 핸들러는 할 일을 표시만 하고 인터럽트를 켠 채 IRQ 종료 시 처리)
+// 종류별 보류 비트는 CPU별이고, 표시한 CPU에서 처리
+
+#define SOFTIRQ_TIMER 0             // 타이머 휠과 로드 평균 (CPU 0)
+#define SOFTIRQ_TASKLET 1           // 태스클릿
+#define SOFTIRQ_COUNT 2
+
+#define SOFTIRQ_MAX_RESTART 4       // 처리 중 다시 표시되면 반복하는 최대 횟수 (남으면 다음 IRQ 종료나 유휴 루프에서)
+
+typedef void (*softirq_handler_t)(void);
+
+// 태스클릿 (같은 태스클릿은 동시에 한 CPU에서만 실행, 실행 전에 다시 예약하면 한 번만 실행)
+typedef struct tasklet {
+    struct tasklet* next;
+    volatile uint32_t state;        // TASKLET_SCHEDULED, TASKLET_RUNNING
+    void (*func)(void* data);
+    void* data;
+} tasklet_t;
+
+#define TASKLET_SCHEDULED 0x1
+#define TASKLET_RUNNING 0x2
+
+#define TASKLET_INIT(func, data) { NULL, 0, (func), (data) }
+
+// softirq 함수들 (raise_softirq는 인터럽트 핸들러에서도 호출 가능)
+void open_softirq(uint32_t nr, softirq_handler_t handler);
+void raise_softirq(uint32_t nr);
+uint32_t softirq_pending(void);
+void softirq_run(void);
+void irq_exit(void);
+
+// 태스클릿 함수들
+void tasklet_init(tasklet_t* tasklet, void (*func)(void* data), void* data);
+void tasklet_schedule(tasklet_t* tasklet);
+
+#endif // SOFTIRQ_H
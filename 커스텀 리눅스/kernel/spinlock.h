@@ -0,0 +1,47 @@
+#ifndef SPINLOCK_H
+#define SPINLOCK_H
+
+#include <stdint.h>
+#include "interrupt.h"
+
+// 스핀락 (CPU 간 상호 배제, 잡고 있는 동안 잠들면 안 됨)
+typedef struct {
+    volatile uint32_t locked;
+} spinlock_t;
+
+#define SPINLOCK_INIT { 0 }
+
+static inline void spin_lock_init(spinlock_t* lock) {
+    lock->locked = 0;
+}
+
+static inline void spin_lock(spinlock_t* lock) {
+    while (__sync_lock_test_and_set(&lock->locked, 1)) {
+        // 캐시 라인을 계속 빼앗지 않도록 풀릴 때까지 읽기만 하며 대기
+        while (lock->locked) {
+            __asm__ volatile("pause" : : : "memory");
+        }
+    }
+}
+
+static inline int spin_trylock(spinlock_t* lock) {
+    return !__sync_lock_test_and_set(&lock->locked, 1);
+}
+
+static inline void spin_unlock(spinlock_t* lock) {
+    __sync_lock_release(&lock->locked);
+}
+
+// 인터럽트 핸들러와도 공유하는 잠금 (같은 CPU에서 재진입 방지)
+static inline uint32_t spin_lock_irqsave(spinlock_t* lock) {
+    uint32_t flags = irq_save();
+    spin_lock(lock);
+    return flags;
+}
+
+static inline void spin_unlock_irqrestore(spinlock_t* lock, uint32_t flags) {
+    spin_unlock(lock);
+    irq_restore(flags);
+}
+
+#endif // SPINLOCK_H
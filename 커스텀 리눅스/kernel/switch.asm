@@ -0,0 +1,48 @@
+; 컨텍스트 스위칭
+; 커널 스택만 교체 (범용 레지스터는 호출 규약상 보존해야 하는 것만 저장)
+
+[bits 32]
+section .text
+
+global switch_stacks
+global process_trampoline
+global fork_trampoline
+extern process_exit
+extern scheduler_finish_switch
+extern account_kernel_exit
+
+; void switch_stacks(uint32_t* old_esp, uint32_t new_esp)
+switch_stacks:
+    mov eax, [esp + 4]      ; 현재 스택 포인터를 저장할 위치
+    mov edx, [esp + 8]      ; 전환할 스택 포인터
+
+    push ebp
+    push ebx
+    push esi
+    push edi
+    mov [eax], esp
+
+    mov esp, edx
+    pop edi
+    pop esi
+    pop ebx
+    pop ebp
+    ret                     ; 새 스택에 저장된 복귀 주소로
+
+; 새 프로세스의 첫 실행 지점 (스택 맨 위에 진입 함수 주소)
+process_trampoline:
+    call scheduler_finish_switch    ; 전환한 CPU의 스케줄러 잠금 해제
+    sti                     ; 인터럽트 처리 중에 전환되어 왔으므로 다시 허용
+    pop eax
+    call eax
+    call process_exit       ; 진입 함수가 반환하면 종료
+.hang:
+    hlt
+    jmp .hang
+
+; fork한 자식의 첫 실행 지점 (스택 위쪽에 부모의 트랩 프레임 복사본, 바로 아래에 복귀 경로 주소)
+; 인터럽트를 끈 채 복귀 경로로 가서 부모와 같은 시스템 콜 지점에서 사용자 모드로 돌아감
+fork_trampoline:
+    call scheduler_finish_switch
+    call account_kernel_exit
+    ret                     ; interrupt_return 또는 sysenter_return
@@ -0,0 +1,125 @@
+#include "sync.h"
+#include "scheduler.h"
+
+// 뮤텍스 초기화
+void mutex_init(mutex_t* mutex) {
+    mutex->locked = 0;
+    mutex->owner = NULL;
+    wait_queue_init(&mutex->waiters);
+}
+
+// 뮤텍스 획득 시도 (잡았으면 1)
+int mutex_trylock(mutex_t* mutex) {
+    if (!__sync_bool_compare_and_swap(&mutex->locked, 0, 1)) return 0;
+    
+    mutex->owner = process_get_current();
+    return 1;
+}
+
+// 뮤텍스 획득 (풀릴 때까지 잠듦)
+void mutex_lock(mutex_t* mutex) {
+    if (mutex_trylock(mutex)) return;
+    
+    // 해제하는 쪽도 큐 잠금 아래에서 풀고 깨우므로 확인과 잠들기 사이에 풀려도 놓치지 않음
+    uint32_t flags = spin_lock_irqsave(&mutex->waiters.lock);
+    while (!__sync_bool_compare_and_swap(&mutex->locked, 0, 1)) {
+        wait_queue_sleep_locked(&mutex->waiters, NULL, WAIT_EXCLUSIVE, 0);
+    }
+    spin_unlock_irqrestore(&mutex->waiters.lock, flags);
+    
+    mutex->owner = process_get_current();
+}
+
+// 뮤텍스 해제 (기다리는 프로세스 하나를 깨움, 깨어난 쪽이 다시 경쟁)
+void mutex_unlock(mutex_t* mutex) {
+    mutex->owner = NULL;
+    
+    uint32_t flags = spin_lock_irqsave(&mutex->waiters.lock);
+    __sync_lock_release(&mutex->locked);
+    wake_up_locked(&mutex->waiters, NULL, 1);
+    spin_unlock_irqrestore(&mutex->waiters.lock, flags);
+}
+
+// 세마포어 초기화
+void semaphore_init(semaphore_t* sem, uint32_t count) {
+    sem->count = count;
+    wait_queue_init(&sem->waiters);
+}
+
+// 자원 획득 (없으면 timeout 틱까지 잠듦, 0이면 기한 없음)
+// 얻었으면 0, 시간이 지났으면 -1
+int semaphore_down_timeout(semaphore_t* sem, uint32_t timeout) {
+    int result = 0;
+    uint32_t flags = spin_lock_irqsave(&sem->waiters.lock);
+    
+    while (!sem->count) {
+        if (wait_queue_sleep_locked(&sem->waiters, NULL, WAIT_EXCLUSIVE, timeout) < 0 && timeout) {
+            result = -1;
+            break;
+        }
+    }
+    if (!result) {
+        sem->count--;
+    }
+    
+    spin_unlock_irqrestore(&sem->waiters.lock, flags);
+    return result;
+}
+
+void semaphore_down(semaphore_t* sem) {
+    semaphore_down_timeout(sem, 0);
+}
+
+// 자원 획득 시도 (얻었으면 1)
+int semaphore_trydown(semaphore_t* sem) {
+    int acquired = 0;
+    uint32_t flags = spin_lock_irqsave(&sem->waiters.lock);
+    
+    if (sem->count) {
+        sem->count--;
+        acquired = 1;
+    }
+    
+    spin_unlock_irqrestore(&sem->waiters.lock, flags);
+    return acquired;
+}
+
+// 자원 반납 (인터럽트 핸들러에서도 호출 가능)
+void semaphore_up(semaphore_t* sem) {
+    uint32_t flags = spin_lock_irqsave(&sem->waiters.lock);
+    sem->count++;
+    wake_up_locked(&sem->waiters, NULL, 1);
+    spin_unlock_irqrestore(&sem->waiters.lock, flags);
+}
+
+// 조건 변수 초기화
+void condvar_init(condvar_t* cond) {
+    wait_queue_init(&cond->waiters);
+}
+
+// 뮤텍스를 놓고 신호를 기다린 뒤 다시 잡음 (깨웠으면 0, timeout 틱이 지났으면 -1)
+// 대기 큐에 들어간 뒤에 뮤텍스를 놓으므로 그 사이의 신호를 놓치지 않음
+// 다른 깨우기로 돌아올 수도 있으므로 호출자는 조건을 다시 확인
+int condvar_wait_timeout(condvar_t* cond, mutex_t* mutex, uint32_t timeout) {
+    uint32_t flags = spin_lock_irqsave(&cond->waiters.lock);
+    mutex_unlock(mutex);
+    int result = wait_queue_sleep_locked(&cond->waiters, NULL, WAIT_EXCLUSIVE, timeout);
+    spin_unlock_irqrestore(&cond->waiters.lock, flags);
+    
+    mutex_lock(mutex);
+    return result;
+}
+
+void condvar_wait(condvar_t* cond, mutex_t* mutex) {
+    condvar_wait_timeout(cond, mutex, 0);
+}
+
+// 기다리는 프로세스 하나 깨우기
+void condvar_signal(condvar_t* cond) {
+    wake_up(&cond->waiters, 1);
+}
+
+// 기다리는 프로세스 모두 깨우기
+void condvar_broadcast(condvar_t* cond) {
+    wake_up(&cond->waiters, WAKE_ALL);
+}
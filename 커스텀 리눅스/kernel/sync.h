@@ -0,0 +1,53 @@
+#ifndef SYNC_H
+#define SYNC_H
+
+#include <stdint.h>
+#include "wait.h"
+
+// 잠드는 동기화 객체 (프로세스 문맥에서만 사용, 인터럽트 핸들러에서는 깨우기 쪽만 가능)
+
+// 뮤텍스 (경합이 없으면 원자적 교환 한 번, 있으면 대기 큐에서 잠듦)
+typedef struct mutex {
+    volatile uint32_t locked;
+    struct process* owner;          // 잡고 있는 프로세스 (디버깅용)
+    wait_queue_t waiters;
+} mutex_t;
+
+#define MUTEX_INIT { 0, NULL, WAIT_QUEUE_INIT }
+
+// 세마포어
+typedef struct semaphore {
+    uint32_t count;                 // 남은 자원 수 (대기 큐 잠금으로 보호)
+    wait_queue_t waiters;
+} semaphore_t;
+
+#define SEMAPHORE_INIT(n) { (n), WAIT_QUEUE_INIT }
+
+// 조건 변수 (뮤텍스로 보호하는 조건을 기다림)
+typedef struct condvar {
+    wait_queue_t waiters;
+} condvar_t;
+
+#define CONDVAR_INIT { WAIT_QUEUE_INIT }
+
+// 뮤텍스 함수들
+void mutex_init(mutex_t* mutex);
+void mutex_lock(mutex_t* mutex);
+int mutex_trylock(mutex_t* mutex);
+void mutex_unlock(mutex_t* mutex);
+
+// 세마포어 함수들
+void semaphore_init(semaphore_t* sem, uint32_t count);
+void semaphore_down(semaphore_t* sem);
+int semaphore_down_timeout(semaphore_t* sem, uint32_t timeout);
+int semaphore_trydown(semaphore_t* sem);
+void semaphore_up(semaphore_t* sem);
+
+// 조건 변수 함수들
+void condvar_init(condvar_t* cond);
+void condvar_wait(condvar_t* cond, mutex_t* mutex);
+int condvar_wait_timeout(condvar_t* cond, mutex_t* mutex, uint32_t timeout);
+void condvar_signal(condvar_t* cond);
+void condvar_broadcast(condvar_t* cond);
+
+#endif // SYNC_H
@@ -0,0 +1,229 @@
+#include "timer.h"
+#include "spinlock.h"
+#include <string.h>
+
+static timer_wheel_t wheel;
+static spinlock_t wheel_lock = SPINLOCK_INIT;   // 타이머는 모든 CPU에서 등록/취소
+static kernel_timer_t* volatile wheel_running;  // 콜백 실행 중인 타이머 (휠은 CPU 0의 timer softirq만 처리)
+
+#define ROOT_MASK (TIMER_WHEEL_ROOT_SIZE - 1)
+#define LEVEL_MASK (TIMER_WHEEL_LEVEL_SIZE - 1)
+
+// 단계별 칸 인덱스 (level 0 = 2단계)
+#define LEVEL_SHIFT(level) (TIMER_WHEEL_ROOT_BITS + (level) * TIMER_WHEEL_LEVEL_BITS)
+#define LEVEL_INDEX(tick, level) (((tick) >> LEVEL_SHIFT(level)) & LEVEL_MASK)
+
+// 칸에 추가 (원형 이중 연결 리스트)
+static void slot_insert(kernel_timer_t** slot, kernel_timer_t* timer) {
+    if (!*slot) {
+        *slot = timer;
+        timer->next = timer;
+        timer->prev = timer;
+    } else {
+        timer->next = *slot;
+        timer->prev = (*slot)->prev;
+        (*slot)->prev->next = timer;
+        (*slot)->prev = timer;
+    }
+    timer->slot = slot;
+}
+
+static void slot_remove(kernel_timer_t* timer) {
+    kernel_timer_t** slot = timer->slot;
+    
+    if (timer->next == timer) {
+        *slot = NULL;
+    } else {
+        timer->prev->next = timer->next;
+        timer->next->prev = timer->prev;
+        if (*slot == timer) {
+            *slot = timer->next;
+        }
+    }
+    
+    timer->next = NULL;
+    timer->prev = NULL;
+    timer->slot = NULL;
+}
+
+// 남은 틱 수로 단계와 칸 결정
+static void wheel_insert(kernel_timer_t* timer) {
+    uint32_t expires = timer->expires;
+    uint32_t delta = expires - wheel.current_tick;
+    kernel_timer_t** slot;
+    
+    if ((int32_t)delta < 0) {
+        // 이미 지난 타이머는 바로 다음 틱에 처리
+        slot = &wheel.root[wheel.current_tick & ROOT_MASK];
+    } else if (delta < TIMER_WHEEL_ROOT_SIZE) {
+        slot = &wheel.root[expires & ROOT_MASK];
+    } else {
+        uint32_t level = 0;
+        while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1u << LEVEL_SHIFT(level + 1))) {
+            level++;
+        }
+        slot = &wheel.levels[level][LEVEL_INDEX(expires, level)];
+    }
+    
+    slot_insert(slot, timer);
+}
+
+// 상위 단계 칸의 타이머를 한 단계 아래로 재배치
+static uint32_t wheel_cascade(uint32_t level) {
+    uint32_t index = LEVEL_INDEX(wheel.current_tick, level);
+    kernel_timer_t** slot = &wheel.levels[level][index];
+    
+    while (*slot) {
+        kernel_timer_t* timer = *slot;
+        slot_remove(timer);
+        wheel_insert(timer);
+    }
+    
+    return index;
+}
+
+// 타이머 휠 초기화
+void timer_wheel_init(uint32_t now) {
+    memset(&wheel, 0, sizeof(wheel));
+    wheel.current_tick = now;
+}
+
+// now까지의 틱 처리 (틱당 비용은 만료되는 타이머 수에 비례)
+void timer_wheel_run(uint32_t now) {
+    uint32_t flags = spin_lock_irqsave(&wheel_lock);
+    
+    while ((int32_t)(now - wheel.current_tick) >= 0) {
+        uint32_t index = wheel.current_tick & ROOT_MASK;
+        
+        // 1단계가 한 바퀴 돌면 상위 단계에서 내려옴
+        if (!index) {
+            for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+                if (wheel_cascade(level)) break;
+            }
+        }
+        
+        wheel.current_tick++;
+        
+        kernel_timer_t** slot = &wheel.root[index];
+        while (*slot) {
+            kernel_timer_t* timer = *slot;
+            slot_remove(timer);
+            wheel.pending--;
+            wheel_running = timer;
+            
+            // 콜백 안에서 타이머를 다시 등록할 수 있음
+            spin_unlock_irqrestore(&wheel_lock, flags);
+            timer->callback(timer->data);
+            flags = spin_lock_irqsave(&wheel_lock);
+            wheel_running = NULL;
+        }
+    }
+    
+    spin_unlock_irqrestore(&wheel_lock, flags);
+}
+
+// 다음으로 처리가 필요한 틱 (상위 단계는 재배치 시점까지만 보장, 타이머가 없으면 아주 먼 틱)
+uint32_t timer_wheel_next_expiry(void) {
+    uint32_t flags = spin_lock_irqsave(&wheel_lock);
+    uint32_t current = wheel.current_tick;
+    uint32_t next = current + 0x7FFFFFFF;
+    
+    if (wheel.pending) {
+        // 1단계에는 256틱 안에 만료되는 타이머만 있음
+        for (uint32_t i = 0; i < TIMER_WHEEL_ROOT_SIZE; i++) {
+            if (wheel.root[(current + i) & ROOT_MASK]) {
+                next = current + i;
+                break;
+            }
+        }
+        
+        // 상위 단계는 비어 있지 않은 가장 가까운 칸이 내려오는 시점
+        for (uint32_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+            uint32_t shift = LEVEL_SHIFT(level);
+            uint32_t first = current & ~((1u << shift) - 1);
+            if (current & ((1u << shift) - 1)) {
+                first += 1u << shift;
+            }
+            
+            for (uint32_t j = 0; j < TIMER_WHEEL_LEVEL_SIZE; j++) {
+                uint32_t tick = first + (j << shift);
+                if ((int32_t)(tick - next) >= 0) break;
+                if (wheel.levels[level][LEVEL_INDEX(tick, level)]) {
+                    next = tick;
+                    break;
+                }
+            }
+        }
+    }
+    
+    spin_unlock_irqrestore(&wheel_lock, flags);
+    return next;
+}
+
+void kernel_timer_init(kernel_timer_t* timer) {
+    memset(timer, 0, sizeof(kernel_timer_t));
+}
+
+// delay 틱 뒤에 callback 호출 (이미 등록된 타이머는 다시 설정)
+void kernel_timer_add(kernel_timer_t* timer, uint32_t delay, kernel_timer_callback_t callback, void* data) {
+    if (!timer || !callback) return;
+    
+    uint32_t flags = spin_lock_irqsave(&wheel_lock);
+    
+    if (timer->slot) {
+        slot_remove(timer);
+        wheel.pending--;
+    }
+    
+    timer->expires = wheel.current_tick + delay;
+    timer->callback = callback;
+    timer->data = data;
+    wheel_insert(timer);
+    wheel.pending++;
+    
+    spin_unlock_irqrestore(&wheel_lock, flags);
+}
+
+// 타이머 취소 (등록되어 있었으면 1 반환)
+int kernel_timer_cancel(kernel_timer_t* timer) {
+    if (!timer) return 0;
+    
+    uint32_t flags = spin_lock_irqsave(&wheel_lock);
+    int pending = timer->slot != NULL;
+    
+    if (pending) {
+        slot_remove(timer);
+        wheel.pending--;
+    }
+    
+    spin_unlock_irqrestore(&wheel_lock, flags);
+    return pending;
+}
+
+// 타이머 취소 후 이미 시작된 콜백이 끝날 때까지 대기 (등록되어 있었으면 1 반환)
+// 콜백이 쓰는 구조체를 해제하기 전에 사용, 콜백 안이나 콜백이 잡는 잠금을 쥔 채로 호출하면 안 됨
+int kernel_timer_cancel_sync(kernel_timer_t* timer) {
+    if (!timer) return 0;
+    
+    int pending = 0;
+    for (;;) {
+        uint32_t flags = spin_lock_irqsave(&wheel_lock);
+        if (timer->slot) {
+            slot_remove(timer);
+            wheel.pending--;
+            pending = 1;
+        }
+        int running = wheel_running == timer;
+        spin_unlock_irqrestore(&wheel_lock, flags);
+        if (!running) return pending;
+        
+        // 콜백이 자신을 다시 등록할 수 있으므로 끝난 뒤 한 번 더 취소
+        while (wheel_running == timer) {
+            __asm__ volatile("pause" : : : "memory");
+        }
+    }
+}
+
+int kernel_timer_pending(const kernel_timer_t* timer) {
+    return timer && timer->slot != NULL;
+}
@@ -0,0 +1,45 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 계층형 타이머 휠 크기 (1단계 256칸, 2~5단계 64칸)
+#define TIMER_WHEEL_ROOT_BITS 8
+#define TIMER_WHEEL_LEVEL_BITS 6
+#define TIMER_WHEEL_ROOT_SIZE (1 << TIMER_WHEEL_ROOT_BITS)
+#define TIMER_WHEEL_LEVEL_SIZE (1 << TIMER_WHEEL_LEVEL_BITS)
+#define TIMER_WHEEL_LEVELS 4
+
+// 타이머 만료 콜백 (timer softirq에서 인터럽트를 켠 상태로 호출, 잠들면 안 됨)
+typedef void (*kernel_timer_callback_t)(void* data);
+
+// 커널 타이머 (호출자가 가진 구조체 안에 포함해서 사용)
+typedef struct kernel_timer {
+    struct kernel_timer* next;      // 같은 칸의 다음 타이머
+    struct kernel_timer* prev;      // 같은 칸의 이전 타이머
+    struct kernel_timer** slot;     // 등록된 칸 (등록되지 않았으면 NULL)
+    uint32_t expires;               // 만료 틱
+    kernel_timer_callback_t callback;
+    void* data;
+} kernel_timer_t;
+
+// 타이머 휠 구조체
+typedef struct timer_wheel {
+    uint32_t current_tick;          // 다음에 처리할 틱
+    uint32_t pending;               // 등록된 타이머 수
+    kernel_timer_t* root[TIMER_WHEEL_ROOT_SIZE];
+    kernel_timer_t* levels[TIMER_WHEEL_LEVELS][TIMER_WHEEL_LEVEL_SIZE];
+} timer_wheel_t;
+
+// 타이머 휠 함수들
+void timer_wheel_init(uint32_t now);
+void timer_wheel_run(uint32_t now);
+uint32_t timer_wheel_next_expiry(void);
+void kernel_timer_init(kernel_timer_t* timer);
+void kernel_timer_add(kernel_timer_t* timer, uint32_t delay, kernel_timer_callback_t callback, void* data);
+int kernel_timer_cancel(kernel_timer_t* timer);
+int kernel_timer_cancel_sync(kernel_timer_t* timer);
+int kernel_timer_pending(const kernel_timer_t* timer);
+
+#endif // TIMER_H
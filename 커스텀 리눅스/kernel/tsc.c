@@ -0,0 +1,50 @@
+#include "tsc.h"
+#include "pit.h"
+
+#define CPUID_FEATURE_TSC (1 << 4)
+
+// PIT 채널 2로 잰 구간 (10ms를 여러 번 재서 가장 짧은 값, SMI 등으로 늘어난 측정은 버림)
+#define TSC_CALIBRATE_MS 10
+#define TSC_CALIBRATE_TRIES 5
+
+uint32_t tsc_khz = 0;
+
+// 클럭 → us 배율 ((1000 << TSC_SHIFT) / tsc_khz, 64비트 나눗셈 없이 곱셈과 시프트로 변환)
+static uint32_t tsc_us_mult = 0;
+
+// TSC 주파수 보정 (인터럽트를 끈 부팅 초기에 BSP에서 한 번)
+void tsc_init(void) {
+    uint32_t eax, ebx, ecx, edx;
+    __asm__ volatile("cpuid" : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) : "a" (1));
+    if (!(edx & CPUID_FEATURE_TSC)) return;
+    
+    uint64_t best = ~0ULL;
+    for (int i = 0; i < TSC_CALIBRATE_TRIES; i++) {
+        pit_channel2_start(PIT_FREQUENCY / (1000 / TSC_CALIBRATE_MS));
+        uint64_t start = tsc_read();
+        while (!pit_channel2_expired()) {
+            __asm__ volatile("pause");
+        }
+        uint64_t elapsed = tsc_read() - start;
+        
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    
+    // 10ms 동안의 클럭 수는 4GHz에서도 32비트 안
+    if (best >> 32) return;
+    tsc_khz = (uint32_t)best / TSC_CALIBRATE_MS;
+    if (tsc_khz) {
+        tsc_us_mult = (1000u << TSC_SHIFT) / tsc_khz;
+    }
+}
+
+// 클럭 수를 us로 (상위/하위 32비트를 따로 곱해 64비트를 넘지 않도록)
+uint64_t tsc_cycles_to_us(uint64_t cycles) {
+    uint32_t high = (uint32_t)(cycles >> 32);
+    uint32_t low = (uint32_t)cycles;
+    
+    return (((uint64_t)high * tsc_us_mult) << (32 - TSC_SHIFT)) +
+           (((uint64_t)low * tsc_us_mult) >> TSC_SHIFT);
+}
@@ -0,0 +1,23 @@
+#ifndef TSC_H
+#define TSC_H
+
+#include <stdint.h>
+
+// TSC (Time Stamp Counter) 시간 측정
+// 클럭 수는 CPU마다 따로 세므로 같은 CPU에서 읽은 두 값의 차이만 사용
+
+#define TSC_SHIFT 22                // 클럭 → us 변환 배율의 고정소수점 자리
+
+extern uint32_t tsc_khz;            // 1ms당 클럭 수 (TSC가 없으면 0)
+
+static inline uint64_t tsc_read(void) {
+    uint32_t low, high;
+    __asm__ volatile("rdtsc" : "=a" (low), "=d" (high));
+    return ((uint64_t)high << 32) | low;
+}
+
+// TSC 함수들
+void tsc_init(void);
+uint64_t tsc_cycles_to_us(uint64_t cycles);
+
+#endif // TSC_H
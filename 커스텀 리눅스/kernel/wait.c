@@ -0,0 +1,111 @@
+#include "wait.h"
+#include "scheduler.h"
+
+void wait_queue_init(wait_queue_t* wq) {
+    spin_lock_init(&wq->lock);
+    wq->head = NULL;
+    wq->tail = NULL;
+}
+
+// 대기자 추가 (배타 대기자는 뒤에, 나머지는 비배타 대기자의 끝에)
+static void wait_entry_add(wait_queue_t* wq, wait_entry_t* entry) {
+    wait_entry_t* prev = wq->tail;
+    if (!(entry->flags & WAIT_EXCLUSIVE)) {
+        prev = NULL;
+        for (wait_entry_t* e = wq->head; e && !(e->flags & WAIT_EXCLUSIVE); e = e->next) {
+            prev = e;
+        }
+    }
+    
+    entry->prev = prev;
+    entry->next = prev ? prev->next : wq->head;
+    if (entry->next) {
+        entry->next->prev = entry;
+    } else {
+        wq->tail = entry;
+    }
+    if (prev) {
+        prev->next = entry;
+    } else {
+        wq->head = entry;
+    }
+}
+
+static void wait_entry_remove(wait_queue_t* wq, wait_entry_t* entry) {
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        wq->head = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    } else {
+        wq->tail = entry->prev;
+    }
+    entry->next = NULL;
+    entry->prev = NULL;
+}
+
+// 현재 프로세스를 큐에 넣고 재움 (큐 잠금을 잡고 호출, 돌아올 때 다시 잡은 상태)
+// 대기 조건은 같은 잠금 아래에서 확인하므로 확인과 잠들기 사이의 깨우기를 놓치지 않음
+// 깨워졌으면 0, timeout 틱이 지났거나 다른 이유로 깨어났으면 -1 (timeout이 0이면 기한 없음)
+int wait_queue_sleep_locked(wait_queue_t* wq, const void* key, uint32_t flags, uint32_t timeout) {
+    process_t* current = process_get_current();
+    if (!current) return -1; // 유휴 문맥은 잠들 수 없음
+    
+    wait_entry_t entry;
+    entry.process = current;
+    entry.key = key;
+    entry.flags = flags;
+    entry.woken = 0;
+    wait_entry_add(wq, &entry);
+    
+    // 대기 상태로 바꾼 뒤 잠금을 놓으므로 그사이의 깨우기는 전환 없이 준비 상태로 되돌림
+    process_prepare_wait(timeout);
+    spin_unlock(&wq->lock);
+    scheduler_schedule();
+    spin_lock(&wq->lock);
+    
+    if (!entry.woken) {
+        wait_entry_remove(wq, &entry);
+        return -1;
+    }
+    return 0;
+}
+
+// key가 맞는 대기자 깨우기 (key가 NULL이면 모두 맞음, 큐 잠금을 잡고 호출)
+// 비배타 대기자는 모두, 배타 대기자는 nr_exclusive개까지 깨우고 깨운 수를 반환
+uint32_t wake_up_locked(wait_queue_t* wq, const void* key, uint32_t nr_exclusive) {
+    uint32_t woken = 0;
+    wait_entry_t* entry = wq->head;
+    
+    while (entry && nr_exclusive) {
+        wait_entry_t* next = entry->next;
+        
+        if (!key || entry->key == key) {
+            process_t* process = entry->process;
+            uint32_t exclusive = entry->flags & WAIT_EXCLUSIVE;
+            
+            // 대기자는 큐 잠금을 다시 잡은 뒤에야 스택의 항목을 버리므로 여기서는 유효
+            wait_entry_remove(wq, entry);
+            entry->woken = 1;
+            process_wake(process);
+            woken++;
+            
+            if (exclusive && nr_exclusive != WAKE_ALL) {
+                nr_exclusive--;
+            }
+        }
+        entry = next;
+    }
+    
+    return woken;
+}
+
+// 대기자 깨우기 (비배타 대기자 모두와 배타 대기자 nr_exclusive개)
+uint32_t wake_up(wait_queue_t* wq, uint32_t nr_exclusive) {
+    uint32_t flags = spin_lock_irqsave(&wq->lock);
+    uint32_t woken = wake_up_locked(wq, NULL, nr_exclusive);
+    spin_unlock_irqrestore(&wq->lock, flags);
+    return woken;
+}
@@ -0,0 +1,39 @@
+#ifndef WAIT_H
+#define WAIT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "spinlock.h"
+
+struct process;
+
+// 대기 항목 (대기하는 동안 대기자의 커널 스택에 있음)
+typedef struct wait_entry {
+    struct process* process;        // 대기하는 프로세스
+    const void* key;                // 깨우기가 고르는 키 (같은 큐를 여러 객체가 나눠 쓸 때)
+    uint32_t flags;                 // WAIT_EXCLUSIVE
+    volatile uint32_t woken;        // 깨운 쪽이 큐에서 꺼내며 설정
+    struct wait_entry* next;
+    struct wait_entry* prev;
+} wait_entry_t;
+
+#define WAIT_EXCLUSIVE 0x1          // 깨우기 한 번에 정해진 수만 깨움 (큐 뒤쪽에 추가)
+#define WAKE_ALL 0xFFFFFFFF         // 배타 대기자도 모두 깨움
+
+// 대기 큐 (기다리는 객체마다 하나, 깨우기는 그 객체의 대기자만 훑음)
+// 0으로 채운 구조체는 빈 큐
+typedef struct wait_queue {
+    spinlock_t lock;                // 대기자 목록과 대기 조건 보호 (인터럽트 핸들러도 깨우므로 irqsave)
+    wait_entry_t* head;             // 비배타 대기자가 앞, 배타 대기자가 뒤 (각각 FIFO)
+    wait_entry_t* tail;
+} wait_queue_t;
+
+#define WAIT_QUEUE_INIT { SPINLOCK_INIT, NULL, NULL }
+
+// 대기 큐 함수들 (_locked는 호출자가 큐 잠금을 잡은 상태)
+void wait_queue_init(wait_queue_t* wq);
+int wait_queue_sleep_locked(wait_queue_t* wq, const void* key, uint32_t flags, uint32_t timeout);
+uint32_t wake_up_locked(wait_queue_t* wq, const void* key, uint32_t nr_exclusive);
+uint32_t wake_up(wait_queue_t* wq, uint32_t nr_exclusive);
+
+#endif // WAIT_H
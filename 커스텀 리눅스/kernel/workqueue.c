@@ -0,0 +1,94 @@
+#include "workqueue.h"
+#include "memory.h"
+#include "smp.h"
+
+workqueue_t* system_wq = NULL;
+
+// 작업 초기화
+void work_init(work_t* work, void (*func)(work_t* work)) {
+    work->next = NULL;
+    work->func = func;
+    work->pending = 0;
+}
+
+// 작업자 스레드 (작업이 없으면 잠들고, 꺼낸 작업은 잠금을 푼 뒤 실행)
+static void worker_main(void* data) {
+    workqueue_t* wq = (workqueue_t*)data;
+    
+    while (1) {
+        uint32_t flags = spin_lock_irqsave(&wq->wait.lock);
+        while (!wq->head) {
+            wait_queue_sleep_locked(&wq->wait, NULL, WAIT_EXCLUSIVE, 0);
+        }
+        
+        work_t* work = wq->head;
+        wq->head = work->next;
+        if (!wq->head) {
+            wq->tail = NULL;
+        }
+        work->next = NULL;
+        work->pending = 0;
+        spin_unlock_irqrestore(&wq->wait.lock, flags);
+        
+        work->func(work);
+    }
+}
+
+// 작업 큐 생성 (작업자 수는 1 ~ WORKQUEUE_MAX_WORKERS)
+workqueue_t* workqueue_create(const char* name, uint32_t workers, priority_t priority) {
+    workqueue_t* wq = (workqueue_t*)kmalloc(sizeof(workqueue_t));
+    if (!wq) return NULL;
+    
+    wq->name = name;
+    wait_queue_init(&wq->wait);
+    wq->head = NULL;
+    wq->tail = NULL;
+    wq->worker_count = 0;
+    
+    if (workers < 1) workers = 1;
+    if (workers > WORKQUEUE_MAX_WORKERS) workers = WORKQUEUE_MAX_WORKERS;
+    for (uint32_t i = 0; i < workers; i++) {
+        process_t* worker = kthread_create(name, worker_main, wq, priority);
+        if (!worker) break;
+        wq->workers[wq->worker_count++] = worker;
+    }
+    
+    // 작업자를 하나도 못 만들었으면 넣은 작업이 영원히 실행되지 않음
+    if (!wq->worker_count) {
+        kfree(wq);
+        return NULL;
+    }
+    return wq;
+}
+
+// 작업 넣기 (작업자 하나를 깨움)
+int queue_work(workqueue_t* wq, work_t* work) {
+    uint32_t flags = spin_lock_irqsave(&wq->wait.lock);
+    if (work->pending) {
+        spin_unlock_irqrestore(&wq->wait.lock, flags);
+        return 0;
+    }
+    
+    work->pending = 1;
+    work->next = NULL;
+    if (wq->tail) {
+        wq->tail->next = work;
+    } else {
+        wq->head = work;
+    }
+    wq->tail = work;
+    wake_up_locked(&wq->wait, NULL, 1);
+    
+    spin_unlock_irqrestore(&wq->wait.lock, flags);
+    return 1;
+}
+
+// 시스템 작업 큐에 넣기
+int schedule_work(work_t* work) {
+    return queue_work(system_wq, work);
+}
+
+// 시스템 작업 큐 생성 (스케줄러와 SMP 초기화 이후)
+void workqueue_init(void) {
+    system_wq = workqueue_create("events", smp_cpu_count(), PRIORITY_NORMAL);
+}
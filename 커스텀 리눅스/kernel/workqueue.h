@@ -0,0 +1,41 @@
+#ifndef WORKQUEUE_H
+#define WORKQUEUE_H
+
+#include <stdint.h>
+#include "wait.h"
+#include "scheduler.h"
+
+// 작업 큐 (커널 스레드가 프로세스 문맥에서 작업을 실행하므로 작업 본체는 잠들 수 있음)
+// 넣기는 인터럽트 핸들러와 softirq에서도 가능
+
+// 작업 (보통 다른 구조체에 넣고 본체에서 rb_entry처럼 바깥 구조체를 구함)
+typedef struct work {
+    struct work* next;
+    void (*func)(struct work* work);
+    volatile uint32_t pending;      // 큐에 있음 (큐 잠금으로 보호, 실행 직전에 지워 본체가 다시 넣을 수 있음)
+} work_t;
+
+#define WORK_INIT(func) { NULL, (func), 0 }
+
+#define WORKQUEUE_MAX_WORKERS 4
+
+typedef struct workqueue {
+    const char* name;
+    wait_queue_t wait;              // 잠금이 작업 목록도 보호, 할 일이 없는 작업자가 배타 대기
+    work_t* head;                   // 넣은 순서대로 실행 (FIFO)
+    work_t* tail;
+    uint32_t worker_count;
+    process_t* workers[WORKQUEUE_MAX_WORKERS];
+} workqueue_t;
+
+// 시스템 작업 큐 (CPU 수만큼 작업자, schedule_work가 넣는 곳)
+extern workqueue_t* system_wq;
+
+// 작업 큐 함수들 (queue_work는 넣었으면 1, 이미 큐에 있으면 0)
+void workqueue_init(void);
+workqueue_t* workqueue_create(const char* name, uint32_t workers, priority_t priority);
+void work_init(work_t* work, void (*func)(work_t* work));
+int queue_work(workqueue_t* wq, work_t* work);
+int schedule_work(work_t* work);
+
+#endif // WORKQUEUE_H
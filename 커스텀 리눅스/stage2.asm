@@ -4,6 +4,9 @@
 [org 0x8000]        ; Stage 2가 로드되는 주소
 [bits 16]          ; 16비트 모드로 시작
 
+E820_MAP equ 0x5000         ; 커널에 전달할 E820 맵 (엔트리 수 4바이트 + 24바이트 엔트리 배열)
+E820_MAX_ENTRIES equ 64     ; kernel/memory.h와 일치
+
 ; Stage 2 시작
 stage2_start:
     ; 세그먼트 레지스터 재설정
@@ -20,6 +23,9 @@ stage2_start:
     ; A20 게이트 활성화
     call enable_a20
 
+    ; 메모리 맵 수집 (BIOS 호출이므로 보호 모드 전환 전에 수행)
+    call detect_memory
+
     ; GDT 로드
     lgdt [gdt_descriptor]
 
@@ -93,6 +99,40 @@ enable_a20:
     out 0x92, al
     ret
 
+; E820 메모리 맵 수집
+detect_memory:
+    pushad
+    xor ebx, ebx                ; 연속 값 (첫 호출은 0)
+    xor bp, bp                  ; 저장한 엔트리 수
+    mov di, E820_MAP + 4        ; ES:DI = 엔트리 저장 위치
+.next:
+    mov eax, 0xE820
+    mov edx, 0x534D4150         ; 'SMAP'
+    mov ecx, 24
+    mov dword [es:di + 20], 1   ; 20바이트만 돌려주는 BIOS를 위한 ACPI 속성 기본값 (유효)
+    int 0x15
+    jc .done                    ; 미지원 또는 목록 끝
+    cmp eax, 0x534D4150
+    jne .done
+
+    ; 길이 0인 엔트리는 건너뜀
+    mov eax, [es:di + 8]
+    or eax, [es:di + 12]
+    jz .skip
+
+    inc bp
+    add di, 24
+    cmp bp, E820_MAX_ENTRIES
+    jae .done
+.skip:
+    test ebx, ebx               ; EBX = 0이면 마지막 엔트리
+    jnz .next
+.done:
+    movzx eax, bp
+    mov [E820_MAP], eax
+    popad
+    ret
+
 ; 커널 로딩 함수
 load_kernel:
     ; 여기에 커널 로딩 코드가 들어갈 예정
@@ -0,0 +1,492 @@
+// 스케줄러 시뮬레이터
+// 커널의 scheduler.c를 그대로 링크하고 1ms 틱마다 timer_handler를 불러 합성 작업 부하를 재생
+// 정책마다 처리량, 깨우기 지연(평균, p99), 공정성, 마감 작업의 마감 초과 횟수를 출력
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "scheduler.h"
+#include "smp.h"
+#include "softirq.h"
+
+#define MAX_TASKS 64
+#define MAX_SAMPLES (1 << 20)
+#define DEFAULT_DURATION 10000  // ms
+
+// 작업 명세 (burst 0이면 계속 CPU 사용, work 0이면 끝까지 실행)
+typedef struct {
+    char name[32];
+    priority_t priority;
+    uint32_t start;                 // 생성 시각 (ms)
+    uint32_t burst;                 // 한 번에 실행하는 시간 (ms)
+    uint32_t sleep;                 // 실행 뒤 잠드는 시간 (ms)
+    uint32_t work;                  // 이만큼 CPU를 쓰면 종료 (ms)
+    uint32_t dl_runtime;            // 마감 정책 매개변수 (ms, runtime이 0이면 기본 정책)
+    uint32_t dl_deadline;
+    uint32_t dl_period;
+} task_spec_t;
+
+// 작업 상태
+typedef struct {
+    task_spec_t spec;
+    process_t* process;
+    uint32_t burst_left;            // 이번 실행에서 남은 시간
+    uint32_t cpu_time;              // 받은 CPU 시간 (ms)
+    uint32_t bursts;                // 끝낸 실행 횟수
+    int sleeping;                   // 슬립 중
+    int waiting;                    // 깨어났지만 아직 실행되지 않음
+    uint32_t wake_time;             // 깨어난 시각 (waiting일 때)
+    uint32_t wakeups;               // 깨어나 실행된 횟수
+    uint64_t latency_sum;           // 깨우기 지연 합 (ms)
+    uint32_t latency_max;
+    uint32_t job_deadline;          // 이번 실행을 시작할 때의 절대 마감 (마감 작업)
+    uint32_t misses;                // 마감을 넘겨 끝난 실행 횟수
+    int exited;
+} task_t;
+
+// 정책 이름
+static const struct {
+    const char* name;
+    sched_policy_t policy;
+} policies[] = {
+    { "fair", SCHED_FAIR },
+    { "rr", SCHED_ROUND_ROBIN },
+    { "priority", SCHED_PRIORITY },
+};
+
+#define POLICY_COUNT (sizeof(policies) / sizeof(policies[0]))
+
+static const char* priority_names[PRIORITY_LEVELS] = { "low", "normal", "high", "realtime" };
+
+static task_spec_t specs[MAX_TASKS];
+static int has_deadline = 0;
+static uint32_t spec_count = 0;
+
+static task_t tasks[MAX_TASKS];
+static uint32_t* samples;
+static uint32_t sample_count = 0;
+static uint32_t switch_count = 0;
+static process_t* last_current = NULL;
+
+static void add_spec(const char* name, priority_t priority, uint32_t start,
+                     uint32_t burst, uint32_t sleep, uint32_t work) {
+    if (spec_count >= MAX_TASKS) return;
+    
+    task_spec_t* spec = &specs[spec_count++];
+    snprintf(spec->name, sizeof(spec->name), "%s", name);
+    spec->priority = priority;
+    spec->start = start;
+    spec->burst = burst;
+    spec->sleep = sleep;
+    spec->work = work;
+    spec->dl_runtime = 0;
+}
+
+// 마지막으로 추가한 작업을 마감 정책으로 (실행이 끝나면 양보해 다음 주기까지 대기)
+static void set_spec_deadline(uint32_t runtime, uint32_t deadline, uint32_t period) {
+    task_spec_t* spec = &specs[spec_count - 1];
+    spec->priority = PRIORITY_REALTIME;
+    spec->dl_runtime = runtime;
+    spec->dl_deadline = deadline;
+    spec->dl_period = period;
+    has_deadline = 1;
+}
+
+// 내장 작업 부하
+static int load_workload(const char* name) {
+    char task_name[32];
+    
+    if (!strcmp(name, "mixed")) {
+        // CPU를 계속 쓰는 작업과 짧게 실행하고 잠드는 대화형 작업이 섞인 경우
+        for (int i = 0; i < 4; i++) {
+            snprintf(task_name, sizeof(task_name), "batch%d", i);
+            add_spec(task_name, PRIORITY_NORMAL, 0, 0, 0, 0);
+        }
+        for (int i = 0; i < 4; i++) {
+            snprintf(task_name, sizeof(task_name), "shell%d", i);
+            add_spec(task_name, PRIORITY_NORMAL, i, 1, 9, 0);
+        }
+        add_spec("backup", PRIORITY_LOW, 0, 0, 0, 0);
+        add_spec("audio", PRIORITY_HIGH, 0, 2, 18, 0);
+    } else if (!strcmp(name, "batch")) {
+        // 우선순위가 다른 CPU 작업들 (가중치대로 나뉘는지)
+        for (int i = 0; i < 6; i++) {
+            snprintf(task_name, sizeof(task_name), "cpu%d", i);
+            add_spec(task_name, (priority_t)(i / 2), 0, 0, 0, 0);
+        }
+    } else if (!strcmp(name, "interactive")) {
+        // 많은 대화형 작업과 CPU 작업 하나
+        for (int i = 0; i < 16; i++) {
+            snprintf(task_name, sizeof(task_name), "ui%d", i);
+            add_spec(task_name, PRIORITY_NORMAL, i, 1 + i % 3, 5 + i, 0);
+        }
+        add_spec("compile", PRIORITY_NORMAL, 0, 0, 0, 0);
+    } else if (!strcmp(name, "control")) {
+        // 주기 제어 루프 (마감 정책)와 CPU 작업, 대화형 작업
+        add_spec("loop10", PRIORITY_REALTIME, 0, 2, 0, 0);
+        set_spec_deadline(2, 10, 10);
+        add_spec("loop20", PRIORITY_REALTIME, 0, 5, 0, 0);
+        set_spec_deadline(5, 20, 20);
+        add_spec("hog", PRIORITY_REALTIME, 0, 0, 0, 0);
+        set_spec_deadline(3, 50, 50);
+        for (int i = 0; i < 4; i++) {
+            snprintf(task_name, sizeof(task_name), "batch%d", i);
+            add_spec(task_name, PRIORITY_HIGH, 0, 0, 0, 0);
+        }
+        add_spec("shell", PRIORITY_NORMAL, 0, 1, 9, 0);
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+static int parse_priority(const char* text, priority_t* priority) {
+    for (int i = 0; i < PRIORITY_LEVELS; i++) {
+        if (!strcmp(text, priority_names[i])) {
+            *priority = (priority_t)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+// 추적 파일 (한 줄에 작업 하나: 이름 우선순위 시작 실행 슬립 총작업, #부터는 주석)
+// 우선순위 자리에 deadline:runtime/deadline/period를 쓰면 마감 정책
+static int load_trace(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return -1;
+    }
+    
+    char line[256];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        char* comment = strchr(line, '#');
+        if (comment) *comment = '\0';
+        
+        char name[32], priority_text[32];
+        unsigned start, burst, sleep, work;
+        int fields = sscanf(line, "%31s %31s %u %u %u %u", name, priority_text, &start, &burst, &sleep, &work);
+        if (fields <= 0) continue;
+        
+        priority_t priority = PRIORITY_REALTIME;
+        unsigned runtime = 0, deadline, period;
+        int valid = fields == 6;
+        if (valid && !strncmp(priority_text, "deadline:", 9)) {
+            valid = sscanf(priority_text + 9, "%u/%u/%u", &runtime, &deadline, &period) == 3 && runtime;
+        } else if (valid) {
+            valid = parse_priority(priority_text, &priority) == 0;
+        }
+        if (!valid) {
+            fprintf(stderr, "%s:%d: 형식 오류 (이름 우선순위 시작 실행 슬립 총작업)\n", path, line_number);
+            fclose(file);
+            return -1;
+        }
+        add_spec(name, priority, start, burst, sleep, work);
+        if (runtime) {
+            set_spec_deadline(runtime, deadline, period);
+        }
+    }
+    
+    fclose(file);
+    return 0;
+}
+
+static void dummy_entry(void) {
+}
+
+static task_t* find_task(process_t* process) {
+    for (uint32_t i = 0; i < spec_count; i++) {
+        if (tasks[i].process == process) return &tasks[i];
+    }
+    return NULL;
+}
+
+// 전환 확인 (깨어난 작업이 처음 실행되면 깨우기 지연 기록)
+static void observe(void) {
+    process_t* current = process_get_current();
+    if (current == last_current) return;
+    
+    switch_count++;
+    last_current = current;
+    
+    task_t* task = find_task(current);
+    if (!task || !task->waiting) return;
+    
+    uint32_t latency = timer_get_ticks() - task->wake_time;
+    task->waiting = 0;
+    task->wakeups++;
+    task->latency_sum += latency;
+    if (latency > task->latency_max) {
+        task->latency_max = latency;
+    }
+    if (sample_count < MAX_SAMPLES) {
+        samples[sample_count++] = latency;
+    }
+}
+
+// 현재 작업이 1ms 실행 (실행이나 총작업을 끝냈으면 그 작업, 처리는 틱 뒤에 finish_burst에서)
+static task_t* run_current(void) {
+    task_t* task = find_task(process_get_current());
+    if (!task) return NULL;
+    
+    task->cpu_time++;
+    if (task->spec.work && task->cpu_time >= task->spec.work) return task;
+    if (!task->spec.burst) return NULL;
+    
+    if (task->burst_left == task->spec.burst) {
+        task->job_deadline = task->process->dl_abs_deadline;
+    }
+    return --task->burst_left ? NULL : task;
+}
+
+// 이번 ms가 끝난 시점 (틱을 처리한 뒤)에 종료하거나 잠들거나 양보
+// 틱보다 먼저 전환하면 다음 작업이 실행하지 않은 ms까지 실행 시간으로 반영되므로
+static void finish_burst(task_t* task) {
+    process_t* process = task->process;
+    
+    if (task->spec.work && task->cpu_time >= task->spec.work) {
+        // process_exit와 같은 순서 (좀비로 만들고 전환, 회수는 하지 않음)
+        scheduler_remove_process(process);
+        process->state = PROCESS_ZOMBIE;
+        task->exited = 1;
+        scheduler_schedule();
+        return;
+    }
+    
+    // 실행을 시작할 때의 마감보다 늦게 끝났으면 초과
+    if (task->spec.dl_runtime && (int32_t)(timer_get_ticks() - task->job_deadline) > 0) {
+        task->misses++;
+    }
+    task->bursts++;
+    task->burst_left = task->spec.burst;
+    if (task->spec.sleep) {
+        task->sleeping = 1;
+        timer_sleep(task->spec.sleep);
+    } else {
+        scheduler_yield();
+    }
+}
+
+static void simulate(sched_policy_t policy, uint32_t duration) {
+    smp_cpus[0].online = 1;
+    scheduler_init();
+    scheduler_set_default_policy(policy);
+    
+    memset(tasks, 0, sizeof(tasks));
+    for (uint32_t i = 0; i < spec_count; i++) {
+        tasks[i].spec = specs[i];
+    }
+    
+    uint32_t now = timer_get_ticks();
+    while (now < duration) {
+        // 시작 시각이 된 작업 생성
+        for (uint32_t i = 0; i < spec_count; i++) {
+            task_t* task = &tasks[i];
+            if (!task->process && task->spec.start <= now) {
+                task->process = process_create(task->spec.name, dummy_entry, task->spec.priority);
+                task->burst_left = task->spec.burst;
+                if (task->spec.dl_runtime &&
+                    scheduler_set_deadline(task->process, task->spec.dl_runtime,
+                                           task->spec.dl_deadline, task->spec.dl_period) < 0) {
+                    fprintf(stderr, "%s: 마감 정책 승인 거부 (기본 정책으로 실행)\n", task->spec.name);
+                }
+            }
+        }
+        scheduler_irq_exit();
+        observe();
+        
+        task_t* finished = run_current();
+        
+        // 틱 인터럽트 (실행 시간 반영과 선점 판단, 슬립 타이머 만료는 인터럽트 종료 시 timer softirq)
+        timer_handler();
+        softirq_run();
+        now = timer_get_ticks();
+        for (uint32_t i = 0; i < spec_count; i++) {
+            task_t* task = &tasks[i];
+            if (task->sleeping && task->process->state != PROCESS_SLEEPING) {
+                task->sleeping = 0;
+                task->waiting = 1;
+                task->wake_time = now;
+            }
+        }
+        if (finished) {
+            finish_burst(finished);
+            observe();
+        }
+        scheduler_irq_exit();
+        observe();
+        
+        // 유휴 루프 (실행할 프로세스가 생겼으면 전환)
+        if (!process_get_current()) {
+            scheduler_schedule();
+            observe();
+        }
+    }
+}
+
+static int compare_u32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// CPU를 계속 쓰는 작업들이 같은 우선순위끼리 받은 몫의 Jain 지수 (우선순위별 최솟값, 1이면 완전 공정)
+static double fairness(uint32_t duration) {
+    double worst = -1.0;
+    
+    for (int level = 0; level < PRIORITY_LEVELS; level++) {
+        double sum = 0.0, square_sum = 0.0;
+        int count = 0;
+        
+        for (uint32_t i = 0; i < spec_count; i++) {
+            task_t* task = &tasks[i];
+            if (task->spec.priority != (priority_t)level || task->spec.burst || task->spec.work ||
+                task->spec.dl_runtime) continue;
+            
+            double share = (double)task->cpu_time / (duration - task->spec.start);
+            sum += share;
+            square_sum += share * share;
+            count++;
+        }
+        
+        if (count < 2) continue;
+        double index = square_sum > 0.0 ? sum * sum / (count * square_sum) : 1.0;
+        if (worst < 0.0 || index < worst) {
+            worst = index;
+        }
+    }
+    return worst;
+}
+
+static void report(const char* name, uint32_t duration, int verbose) {
+    uint64_t cpu_total = 0, latency_total = 0;
+    uint32_t bursts = 0, exited = 0, misses = 0;
+    
+    for (uint32_t i = 0; i < spec_count; i++) {
+        cpu_total += tasks[i].cpu_time;
+        latency_total += tasks[i].latency_sum;
+        bursts += tasks[i].bursts;
+        exited += tasks[i].exited;
+        misses += tasks[i].misses;
+    }
+    
+    qsort(samples, sample_count, sizeof(uint32_t), compare_u32);
+    double seconds = duration / 1000.0;
+    double average = sample_count ? (double)latency_total / sample_count : 0.0;
+    uint32_t p99 = sample_count ? samples[(sample_count * 99 + 99) / 100 - 1] : 0;
+    uint32_t max = sample_count ? samples[sample_count - 1] : 0;
+    double fair = fairness(duration);
+    
+    printf("%-9s %6.1f %9.1f %5u %10.1f %8u %8.2f %8u %8u ",
+           name, cpu_total * 100.0 / duration, bursts / seconds, exited,
+           switch_count / seconds, sample_count, average, p99, max);
+    if (fair < 0.0) {
+        printf("%8s ", "-");
+    } else {
+        printf("%8.3f ", fair);
+    }
+    if (has_deadline) {
+        printf("%7u\n", misses);
+    } else {
+        printf("%7s\n", "-");
+    }
+    
+    if (!verbose) return;
+    
+    for (uint32_t i = 0; i < spec_count; i++) {
+        task_t* task = &tasks[i];
+        printf("  %-12s %-8s cpu %6u ms (%5.1f%%)  wakeups %6u  latency avg %6.2f max %4u",
+               task->spec.name, task->spec.dl_runtime ? "deadline" : priority_names[task->spec.priority],
+               task->cpu_time, task->cpu_time * 100.0 / duration, task->wakeups,
+               task->wakeups ? (double)task->latency_sum / task->wakeups : 0.0, task->latency_max);
+        if (task->spec.dl_runtime) {
+            printf("  misses %u/%u", task->misses, task->bursts);
+        }
+        printf("%s\n", task->exited ? "  (exited)" : "");
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "usage: %s [-p fair|rr|priority|all] [-w mixed|batch|interactive|control] [-t trace] [-d ms] [-v]\n"
+            "  trace: 한 줄에 작업 하나 (이름 우선순위 시작 실행 슬립 총작업, 시간은 ms)\n"
+            "         우선순위 자리에 deadline:runtime/deadline/period를 쓰면 마감 정책\n",
+            program);
+}
+
+int main(int argc, char** argv) {
+    const char* policy_name = "all";
+    const char* workload = "mixed";
+    const char* trace = NULL;
+    uint32_t duration = DEFAULT_DURATION;
+    int verbose = 0;
+    int opt;
+    
+    while ((opt = getopt(argc, argv, "p:w:t:d:vh")) != -1) {
+        switch (opt) {
+        case 'p': policy_name = optarg; break;
+        case 'w': workload = optarg; break;
+        case 't': trace = optarg; break;
+        case 'd': duration = (uint32_t)strtoul(optarg, NULL, 0); break;
+        case 'v': verbose = 1; break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 2;
+        }
+    }
+    
+    if (trace ? load_trace(trace) < 0 : load_workload(workload) < 0) {
+        if (!trace) fprintf(stderr, "알 수 없는 작업 부하: %s\n", workload);
+        return 2;
+    }
+    if (!spec_count || !duration) {
+        usage(argv[0]);
+        return 2;
+    }
+    
+    samples = malloc(MAX_SAMPLES * sizeof(uint32_t));
+    if (!samples) return 1;
+    
+    printf("workload %s, %u tasks, %u ms\n", trace ? trace : workload, spec_count, duration);
+    printf("%-9s %6s %9s %5s %10s %8s %8s %8s %8s %8s %7s\n",
+           "policy", "util%", "bursts/s", "done", "switches/s", "wakeups", "lat-avg", "lat-p99", "lat-max", "fairness",
+           "dl-miss");
+    fflush(stdout);
+    
+    int matched = 0;
+    for (uint32_t i = 0; i < POLICY_COUNT; i++) {
+        if (strcmp(policy_name, "all") && strcmp(policy_name, policies[i].name)) continue;
+        matched = 1;
+        
+        // 스케줄러 상태가 전역이므로 정책마다 새 프로세스에서 실행
+        pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            return 1;
+        }
+        if (pid == 0) {
+            simulate(policies[i].policy, duration);
+            report(policies[i].name, duration, verbose);
+            fflush(stdout);
+            _exit(0);
+        }
+        
+        int status;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+            fprintf(stderr, "%s: 시뮬레이션 실패\n", policies[i].name);
+            return 1;
+        }
+    }
+    
+    if (!matched) {
+        usage(argv[0]);
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,29 @@
+#ifndef APIC_H
+#define APIC_H
+
+// 시뮬레이터용 apic.h (Local APIC 타이머가 없는 것처럼 동작, 틱은 PIT 경로)
+
+#include <stdint.h>
+
+#define LAPIC_TIMER_VECTOR 0xEF
+#define lapic_timer_khz 0u
+
+static inline void lapic_eoi(void) {
+}
+
+static inline void lapic_timer_periodic(uint32_t count) {
+    (void)count;
+}
+
+static inline void lapic_timer_oneshot(uint32_t count) {
+    (void)count;
+}
+
+static inline uint32_t lapic_timer_read_count(void) {
+    return 0;
+}
+
+static inline void lapic_timer_stop(void) {
+}
+
+#endif // APIC_H
@@ -0,0 +1,40 @@
+#ifndef INTERRUPT_H
+#define INTERRUPT_H
+
+// 시뮬레이터용 interrupt.h (인터럽트 플래그는 변수로 흉내)
+
+#include <stdint.h>
+
+typedef void (*interrupt_handler_t)(void);
+
+typedef struct {
+    uint32_t es, ds;
+    uint32_t edx, ecx, eax;
+    uint32_t eip, cs, eflags;
+} interrupt_frame_t;
+
+typedef void (*fast_interrupt_handler_t)(interrupt_frame_t* frame);
+
+#define IRQ0 32
+
+extern uint32_t sim_eflags;
+
+void set_interrupt_handler(uint8_t num, interrupt_handler_t handler);
+void set_fast_interrupt_handler(uint8_t num, fast_interrupt_handler_t handler);
+void enable_interrupts(void);
+void disable_interrupts(void);
+void irq_install_handler(int irq, interrupt_handler_t handler);
+void irq_unmask(uint32_t irq);
+void irq_eoi(uint32_t irq);
+
+static inline uint32_t irq_save(void) {
+    uint32_t flags = sim_eflags;
+    sim_eflags &= ~0x200;
+    return flags;
+}
+
+static inline void irq_restore(uint32_t flags) {
+    sim_eflags |= flags & 0x200;
+}
+
+#endif // INTERRUPT_H
@@ -0,0 +1,17 @@
+#ifndef IRQSTAT_H
+#define IRQSTAT_H
+
+// 시뮬레이터용 irqstat.h (인터럽트 통계는 세지 않음)
+
+#include <stdint.h>
+
+static inline uint32_t irq_stat_start(void) {
+    return 0;
+}
+
+static inline void irq_stat_end(uint32_t vector, uint32_t start) {
+    (void)vector;
+    (void)start;
+}
+
+#endif // IRQSTAT_H
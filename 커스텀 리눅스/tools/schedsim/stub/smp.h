@@ -0,0 +1,46 @@
+#ifndef SMP_H
+#define SMP_H
+
+// 시뮬레이터용 smp.h (CPU 하나, TR 대신 항상 CPU 0)
+
+#include <stdint.h>
+#include "scheduler.h"
+
+#define SMP_MAX_CPUS 1
+#define SMP_ALL_CPUS 0xFFFFFFFF
+#define SMP_NO_CPU 0xFFFFFFFF
+
+typedef struct cpu {
+    uint32_t id;
+    uint32_t apic_id;
+    volatile uint32_t online;
+    scheduler_t sched;
+    struct process* fpu_owner;
+    uint32_t fpu_used;
+    uint32_t idle_stack;
+} cpu_t;
+
+extern cpu_t smp_cpus[SMP_MAX_CPUS];
+
+static inline uint32_t smp_cpu_id(void) {
+    return 0;
+}
+
+static inline cpu_t* smp_this_cpu(void) {
+    return &smp_cpus[0];
+}
+
+static inline cpu_t* smp_get_cpu(uint32_t id) {
+    return &smp_cpus[id];
+}
+
+// 배열 크기 (인라인이라 CPU 순회가 smp_cpus 안에서 끝남을 컴파일러가 앎)
+static inline uint32_t smp_cpu_count(void) {
+    return SMP_MAX_CPUS;
+}
+
+uint32_t smp_online_mask(void);
+void smp_send_reschedule(cpu_t* cpu);
+void smp_send_tick(cpu_t* cpu);
+
+#endif // SMP_H
@@ -0,0 +1,18 @@
+#ifndef TSC_H
+#define TSC_H
+
+// 시뮬레이터용 tsc.h (TSC가 없는 것처럼 동작, CPU 시간 회계는 꺼짐)
+
+#include <stdint.h>
+
+#define tsc_khz 0u
+
+static inline uint64_t tsc_read(void) {
+    return 0;
+}
+
+static inline uint64_t tsc_cycles_to_us(uint64_t cycles) {
+    return cycles;
+}
+
+#endif // TSC_H
@@ -0,0 +1,188 @@
+// 스케줄러가 부르는 커널 함수들의 시뮬레이터 구현
+// 메모리는 호스트 힙에서, 하드웨어(PIT, 페이지 디렉토리, FPU, TSS)와 스택 전환은 아무 일도 하지 않음
+
+#include <stdlib.h>
+#include <string.h>
+#include "interrupt.h"
+#include "smp.h"
+#include "memory.h"
+#include "slab.h"
+#include "buddy.h"
+#include "gdt.h"
+#include "fpu.h"
+#include "pit.h"
+
+uint32_t sim_eflags = 0x200;
+cpu_t smp_cpus[SMP_MAX_CPUS];
+
+// 인터럽트
+void set_interrupt_handler(uint8_t num, interrupt_handler_t handler) {
+    (void)num;
+    (void)handler;
+}
+
+void set_fast_interrupt_handler(uint8_t num, fast_interrupt_handler_t handler) {
+    (void)num;
+    (void)handler;
+}
+
+void enable_interrupts(void) {
+    sim_eflags |= 0x200;
+}
+
+void disable_interrupts(void) {
+    sim_eflags &= ~0x200;
+}
+
+void irq_install_handler(int irq, interrupt_handler_t handler) {
+    (void)irq;
+    (void)handler;
+}
+
+void irq_unmask(uint32_t irq) {
+    (void)irq;
+}
+
+void irq_eoi(uint32_t irq) {
+    (void)irq;
+}
+
+// PIT (시뮬레이터가 직접 timer_handler를 부름)
+void pit_set_periodic(uint32_t frequency) {
+    (void)frequency;
+}
+
+void pit_set_oneshot(uint32_t count) {
+    (void)count;
+}
+
+uint32_t pit_read_count(void) {
+    return 0;
+}
+
+// SMP (CPU 하나)
+uint32_t smp_online_mask(void) {
+    return 1;
+}
+
+void smp_send_reschedule(cpu_t* cpu) {
+    cpu->sched.need_resched = 1;
+}
+
+void smp_send_tick(cpu_t* cpu) {
+    (void)cpu;
+}
+
+// 객체 캐시와 페이지 (커널 구조체의 32비트 주소 필드에 들어가도록 -m32로 빌드)
+kmem_cache_t* kmem_cache_create(const char* name, size_t size, size_t align, kmem_ctor_t ctor) {
+    kmem_cache_t* cache = calloc(1, sizeof(kmem_cache_t));
+    if (!cache) return NULL;
+    
+    strncpy(cache->name, name, sizeof(cache->name) - 1);
+    cache->object_size = size;
+    cache->align = align;
+    cache->ctor = ctor;
+    return cache;
+}
+
+void* kmem_cache_alloc(kmem_cache_t* cache) {
+    void* object = calloc(1, cache->object_size);
+    if (object && cache->ctor) {
+        cache->ctor(object);
+    }
+    return object;
+}
+
+void kmem_cache_free(kmem_cache_t* cache, void* object) {
+    (void)cache;
+    free(object);
+}
+
+void* page_alloc(uint32_t order) {
+    void* page;
+    if (posix_memalign(&page, PAGE_SIZE, PAGE_SIZE << order)) return NULL;
+    return page;
+}
+
+void page_free(void* page, uint32_t order) {
+    (void)order;
+    free(page);
+}
+
+// 주소 공간 (모든 프로세스가 같은 가짜 디렉토리)
+static page_directory_t sim_directory;
+
+page_directory_t* page_directory_create(void) {
+    return &sim_directory;
+}
+
+page_directory_t* page_directory_kernel(void) {
+    return &sim_directory;
+}
+
+page_directory_t* page_directory_current(void) {
+    return &sim_directory;
+}
+
+void page_directory_destroy(page_directory_t* dir) {
+    (void)dir;
+}
+
+void switch_page_directory(page_directory_t* dir) {
+    (void)dir;
+}
+
+// 영역은 만들지 않고 성공만 알림 (목록은 비워 둠)
+static vm_area_t sim_area;
+
+vm_area_t* vm_area_create(vm_area_t** areas, uint32_t start, uint32_t size, uint32_t flags) {
+    (void)areas;
+    (void)start;
+    (void)size;
+    (void)flags;
+    return &sim_area;
+}
+
+void vm_area_destroy_all(vm_area_t** areas, page_directory_t* dir) {
+    (void)dir;
+    *areas = NULL;
+}
+
+int vm_area_fork(vm_area_t** dst_areas, page_directory_t* dst, vm_area_t* src_areas, page_directory_t* src) {
+    (void)dst;
+    (void)src_areas;
+    (void)src;
+    *dst_areas = NULL;
+    return 0;
+}
+
+// 문맥 전환 (프로세스 코드는 실행하지 않으므로 스택은 바꾸지 않고 바로 돌아옴)
+void tss_set_kernel_stack(uint32_t cpu, uint32_t esp0) {
+    (void)cpu;
+    (void)esp0;
+}
+
+void fpu_switch(process_t* prev) {
+    (void)prev;
+}
+
+int fpu_fork(process_t* child, process_t* parent) {
+    (void)child;
+    (void)parent;
+    return 0;
+}
+
+void fpu_release(process_t* process) {
+    (void)process;
+}
+
+void switch_stacks(uint32_t* old_esp, uint32_t new_esp) {
+    (void)old_esp;
+    (void)new_esp;
+}
+
+void process_trampoline(void) {
+}
+
+void fork_trampoline(void) {
+}
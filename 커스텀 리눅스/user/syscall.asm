@@ -0,0 +1,84 @@
+; 사용자 공간 시스템 콜 스텁
+; int syscall(int num, int arg1, int arg2, int arg3)
+; CPU가 SYSENTER를 지원하면 빠른 경로, 아니면 int 0x80 (커널은 두 경로를 같은 시스템 콜 표로 분기)
+
+%define MODE_UNKNOWN 0
+%define MODE_SYSENTER 1
+%define MODE_INT80 2
+%define CPUID_FEATURE_SEP (1 << 11)
+
+[bits 32]
+section .text
+
+global syscall
+
+syscall:
+    cmp dword [syscall_mode], MODE_UNKNOWN
+    jne .ready
+    call detect_mode
+
+.ready:
+    push ebx
+    push ebp
+    mov eax, [esp + 12]     ; 번호
+    mov ebx, [esp + 16]     ; 인자 1
+    mov ecx, [esp + 20]     ; 인자 2
+    mov edx, [esp + 24]     ; 인자 3
+
+    cmp dword [syscall_mode], MODE_SYSENTER
+    jne .int80
+
+    ; SYSEXIT는 edx로 복귀하고 ecx를 스택으로 쓰므로 복귀 주소와 인자 2, 3은 스택으로 넘김
+    ; (커널은 ebp에서 복귀 주소, ebp+4와 ebp+8에서 인자 2, 3을 읽고 ebp+4를 스택으로 돌려줌)
+    push edx
+    push ecx
+    push .sysexit_return
+    mov ebp, esp
+    sysenter
+
+.sysexit_return:
+    add esp, 8              ; 인자 2, 3
+    jmp .done
+
+.int80:
+    int 0x80
+
+.done:
+    pop ebp
+    pop ebx
+    ret
+
+; SYSENTER 지원 확인 (초기 Pentium Pro는 SEP 비트를 켜 두지만 명령을 지원하지 않음, 커널과 같은 판단)
+detect_mode:
+    push ebx
+    mov eax, 1
+    cpuid
+    mov ecx, MODE_INT80
+    test edx, CPUID_FEATURE_SEP
+    jz .store
+
+    mov edx, eax
+    shr edx, 8
+    and edx, 0xF
+    cmp edx, 6              ; 패밀리 6이 아니면 지원
+    jne .supported
+    mov edx, eax
+    shr edx, 4
+    and edx, 0xF
+    cmp edx, 3              ; 모델 3 이상이면 지원
+    jae .supported
+    and eax, 0xF
+    cmp eax, 3              ; 스테핑 3 미만이면 미지원
+    jb .store
+
+.supported:
+    mov ecx, MODE_SYSENTER
+
+.store:
+    mov [syscall_mode], ecx
+    pop ebx
+    ret
+
+section .data
+
+syscall_mode: dd MODE_UNKNOWN
@@ -0,0 +1,20 @@
+#ifndef USER_SYSCALL_H
+#define USER_SYSCALL_H
+
+// 사용자 프로그램용 시스템 콜 인터페이스 (구현은 syscall.asm, 번호는 커널의 register_system_calls와 일치)
+
+#define SYS_READ 0
+#define SYS_WRITE 1
+#define SYS_OPEN 2
+#define SYS_CLOSE 3
+#define SYS_FORK 4
+#define SYS_EXEC 5
+#define SYS_EXIT 6
+#define SYS_BRK 7
+#define SYS_FUTEX 8
+#define SYS_IRQSTAT 9               // (벡터, 통계 버퍼) 버퍼 모양은 커널 irqstat.h의 irq_stat_t
+
+// SYSENTER를 지원하면 빠른 경로, 아니면 int 0x80 (처음 호출할 때 CPUID로 한 번 확인)
+int syscall(int num, int arg1, int arg2, int arg3);
+
+#endif // USER_SYSCALL_H